@@ -43,12 +43,34 @@ int64_t AttackPossibility::attackValue() const
 	return damageDiff() + tacticImpact;
 }
 
+void AttackPossibility::applyTo(HypotheticBattle * state) const
+{
+	auto swb = state->getForUpdate(attack.attacker->unitId());
+	*swb = *attackerState;
+
+	if(damageDealt > 0)
+		swb->removeUnitBonus(Bonus::UntilAttack);
+	if(damageReceived > 0)
+		swb->removeUnitBonus(Bonus::UntilBeingAttacked);
+
+	for(auto affected : affectedUnits)
+	{
+		swb = state->getForUpdate(affected->unitId());
+		*swb = *affected;
+
+		if(damageDealt > 0)
+			swb->removeUnitBonus(Bonus::UntilBeingAttacked);
+		if(damageReceived > 0 && attack.defender->unitId() == affected->unitId())
+			swb->removeUnitBonus(Bonus::UntilAttack);
+	}
+}
+
 AttackPossibility AttackPossibility::evaluate(const BattleAttackInfo & attackInfo, BattleHex hex)
 {
-	const std::string cachingStringBlocksRetaliation = "type_BLOCKS_RETALIATION";
+	static const auto cachingKeyBlocksRetaliation = BonusCacheKey::type(Bonus::BLOCKS_RETALIATION);
 	static const auto selectorBlocksRetaliation = Selector::type(Bonus::BLOCKS_RETALIATION);
 
-	const bool counterAttacksBlocked = attackInfo.attacker->hasBonus(selectorBlocksRetaliation, cachingStringBlocksRetaliation);
+	const bool counterAttacksBlocked = attackInfo.attacker->hasBonus(selectorBlocksRetaliation, cachingKeyBlocksRetaliation);
 
 	AttackPossibility ap(hex, attackInfo);
 
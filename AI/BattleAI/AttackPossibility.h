@@ -32,5 +32,8 @@ public:
 	int64_t damageDiff() const;
 	int64_t attackValue() const;
 
+	///updates attacker and affected units in hypothetic battle with results of this attack
+	void applyTo(HypotheticBattle * state) const;
+
 	static AttackPossibility evaluate(const BattleAttackInfo & attackInfo, BattleHex hex);
 };
@@ -14,7 +14,9 @@
 
 #include "StackWithBonuses.h"
 #include "EnemyInfo.h"
+#include "BattleSearch.h"
 #include "../../lib/CStopWatch.h"
+#include "../../lib/CConfigHandler.h"
 #include "../../lib/CThreadHelper.h"
 #include "../../lib/spells/CSpellHandler.h"
 #include "../../lib/spells/ISpellMechanics.h"
@@ -153,11 +155,22 @@ BattleAction CBattleAI::activeStack( const CStack * stack )
 
 		HypotheticBattle hb(getCbc());
 
-		PotentialTargets targets(stack, &hb);
+		//nothing is changed until action is chosen, so all reachability queries below can share accessibility
+		const AccessibilityInfo accessibility = hb.getAccesibility();
+
+		PotentialTargets targets(stack, &hb, accessibility);
 		if(targets.possibleAttacks.size())
 		{
 			AttackPossibility bestAttack = targets.bestAction();
 
+			const int searchTime = settings["server"]["battleAISearchTime"].Integer();
+			if(searchTime > 0 && targets.possibleAttacks.size() > 1)
+			{
+				BattleSearch search(cb, playerID, searchTime);
+				if(auto searched = search.findBestAttack(stack, targets))
+					bestAttack = *searched;
+			}
+
 			//TODO: consider more complex spellcast evaluation, f.e. because "re-retaliation" during enemy move in same turn for melee attack etc.
 			if(bestSpellcast.is_initialized() && bestSpellcast->value > bestAttack.damageDiff())
 				return BattleAction::makeCreatureSpellcast(stack, bestSpellcast->dest, bestSpellcast->spell->id);
@@ -175,13 +188,13 @@ BattleAction CBattleAI::activeStack( const CStack * stack )
 			if(stack->waited())
 			{
 				//ThreatMap threatsToUs(stack); // These lines may be usefull but they are't used in the code.
-				auto dists = getCbc()->battleGetDistances(stack, stack->getPosition());
+				auto dists = getCbc()->getReachability(stack, accessibility).distances;
 				if(!targets.unreachableEnemies.empty())
 				{
 					const EnemyInfo &ei= *range::min_element(targets.unreachableEnemies, std::bind(isCloser, _1, _2, std::ref(dists)));
 					if(distToNearestNeighbour(ei.s->getPosition(), dists) < GameConstants::BFIELD_SIZE)
 					{
-						return goTowards(stack, ei.s->getPosition());
+						return goTowards(stack, ei.s->getPosition(), accessibility);
 					}
 				}
 			}
@@ -202,7 +215,7 @@ BattleAction CBattleAI::activeStack( const CStack * stack )
 	return BattleAction::makeDefend(stack);
 }
 
-BattleAction CBattleAI::goTowards(const CStack * stack, BattleHex destination)
+BattleAction CBattleAI::goTowards(const CStack * stack, BattleHex destination, const AccessibilityInfo & accessibility)
 {
 	if(!destination.isValid())
 	{
@@ -210,7 +223,7 @@ BattleAction CBattleAI::goTowards(const CStack * stack, BattleHex destination)
 		return BattleAction::makeDefend(stack);
 	}
 
-	auto reachability = cb->getReachability(stack);
+	auto reachability = cb->getReachability(stack, accessibility);
 	auto avHexes = cb->battleGetAvailableHexes(reachability, stack);
 
 	if(vstd::contains(avHexes, destination))
@@ -358,25 +371,7 @@ void CBattleAI::attemptCastingSpell()
 				if(!pt.possibleAttacks.empty())
 				{
 					AttackPossibility ap = pt.bestAction();
-
-					auto swb = state->getForUpdate(unit->unitId());
-					*swb = *ap.attackerState;
-
-					if(ap.damageDealt > 0)
-						swb->removeUnitBonus(Bonus::UntilAttack);
-					if(ap.damageReceived > 0)
-						swb->removeUnitBonus(Bonus::UntilBeingAttacked);
-
-					for(auto affected : ap.affectedUnits)
-					{
-						swb = state->getForUpdate(affected->unitId());
-						*swb = *affected;
-
-						if(ap.damageDealt > 0)
-							swb->removeUnitBonus(Bonus::UntilBeingAttacked);
-						if(ap.damageReceived > 0 && ap.attack.defender->unitId() == affected->unitId())
-							swb->removeUnitBonus(Bonus::UntilAttack);
-					}
+					ap.applyTo(state);
 				}
 
 				auto bav = pt.bestActionValue();
@@ -520,18 +515,9 @@ void CBattleAI::attemptCastingSpell()
 	for(PossibleSpellcast & psc : possibleCasts)
 		tasks.push_back(std::bind(evaluateSpellcast, &psc));
 
-	uint32_t threadCount = boost::thread::hardware_concurrency();
-
-	if(threadCount == 0)
-	{
-		logGlobal->warn("No information of CPU cores available");
-		threadCount = 1;
-	}
-
 	CStopWatch timer;
 
-	CThreadHelper threadHelper(&tasks, threadCount);
-	threadHelper.run();
+	CThreadPool::get().run(tasks);
 
 	LOGFL("Evaluation took %d ms", timer.getDiff());
 
@@ -64,7 +64,7 @@ public:
 	void evaluateCreatureSpellcast(const CStack * stack, PossibleSpellcast & ps); //for offensive damaging spells only
 
 	BattleAction activeStack(const CStack * stack) override; //called when it's turn of that stack
-	BattleAction goTowards(const CStack * stack, BattleHex hex );
+	BattleAction goTowards(const CStack * stack, BattleHex hex, const AccessibilityInfo & accessibility);
 
 	boost::optional<BattleAction> considerFleeingOrSurrendering();
 
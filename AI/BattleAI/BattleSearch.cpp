@@ -0,0 +1,296 @@
+/*
+ * BattleSearch.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BattleSearch.h"
+
+#include "../../lib/CCreatureHandler.h"
+#include "../../lib/CThreadHelper.h"
+
+namespace
+{
+	//splitmix64 finalizer, spreads small values over all bits of key
+	ui64 mix(ui64 x)
+	{
+		x += 0x9E3779B97F4A7C15ULL;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+		return x ^ (x >> 31);
+	}
+
+	std::vector<const AttackPossibility *> orderedAttacks(const std::vector<AttackPossibility> & attacks, size_t limit)
+	{
+		std::vector<const AttackPossibility *> ret;
+		for(auto & ap : attacks)
+			ret.push_back(&ap);
+
+		limit = std::min(limit, ret.size());
+
+		std::partial_sort(ret.begin(), ret.begin() + limit, ret.end(), [](const AttackPossibility * lhs, const AttackPossibility * rhs)
+		{
+			return lhs->attackValue() > rhs->attackValue();
+		});
+
+		ret.resize(limit);
+		return ret;
+	}
+}
+
+BattleSearch::BattleSearch(std::shared_ptr<CBattleCallback> cb_, PlayerColor player_, int timeBudgetMs)
+	: cb(cb_),
+	player(player_),
+	deadline(boost::chrono::steady_clock::now() + boost::chrono::milliseconds(timeBudgetMs))
+{
+}
+
+boost::optional<AttackPossibility> BattleSearch::findBestAttack(const battle::Unit * active, const PotentialTargets & targets)
+{
+	const auto & attacks = targets.possibleAttacks;
+
+	if(attacks.empty())
+		return boost::none;
+
+	std::vector<battle::Units> turnOrder;
+	cb->battleGetTurnOrder(turnOrder, cb->battleGetUnitsIf([](const battle::Unit * u){ return !u->isGhost(); }).size(), 2);
+
+	turns.clear();
+	for(auto & round : turnOrder)
+	{
+		bool newRound = !turns.empty();
+
+		for(auto unit : round)
+		{
+			turns.push_back(Turn{unit->unitId(), newRound});
+			newRound = false;
+		}
+	}
+
+	if(turns.empty() || turns.front().unitId != active->unitId())
+	{
+		logAi->debug("Battle search: %s is not first in turn order", active->getDescription());
+		return boost::none;
+	}
+
+	//states after each root move are prepared here, so search tasks do not share units
+	std::vector<std::unique_ptr<HypotheticBattle>> roots;
+	for(auto & ap : attacks)
+	{
+		roots.push_back(make_unique<HypotheticBattle>(cb));
+		ap.applyTo(roots.back().get());
+	}
+
+	std::vector<Context> contexts(attacks.size());
+	std::vector<int64_t> values(attacks.size(), 0);
+	std::vector<int64_t> depthValues(attacks.size(), 0);
+
+	int completedDepth = 0;
+
+	for(int depth = 1; depth <= MAX_DEPTH && depth <= (int)turns.size(); depth++)
+	{
+		std::vector<std::function<void()>> tasks;
+
+		for(size_t i = 0; i < attacks.size(); i++)
+		{
+			tasks.push_back([&, i, depth]()
+			{
+				auto & ctx = contexts[i];
+				depthValues[i] = search(*roots[i], 1, depth - 1, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), ctx);
+			});
+		}
+
+		CThreadPool::get().run(tasks);
+
+		if(vstd::contains_if(contexts, [](const Context & ctx){ return ctx.timedOut; }))
+			break;
+
+		values = depthValues;
+		completedDepth = depth;
+
+		if(boost::chrono::steady_clock::now() >= deadline)
+			break;
+	}
+
+	ui64 totalNodes = 0;
+	for(auto & ctx : contexts)
+		totalNodes += ctx.nodes;
+
+	logAi->debug("Battle search: %d moves, depth %d, %d nodes", attacks.size(), completedDepth, totalNodes);
+
+	if(completedDepth == 0)
+		return boost::none;
+
+	size_t best = 0;
+	for(size_t i = 1; i < attacks.size(); i++)
+	{
+		if(values[i] > values[best] || (values[i] == values[best] && attacks[i].damageDiff() > attacks[best].damageDiff()))
+			best = i;
+	}
+
+	return attacks[best];
+}
+
+int64_t BattleSearch::search(const HypotheticBattle & state, size_t turnIndex, int depthLeft, int64_t alpha, int64_t beta, Context & ctx) const
+{
+	if(ctx.timedOut || boost::chrono::steady_clock::now() >= deadline)
+	{
+		ctx.timedOut = true;
+		return 0;
+	}
+
+	ctx.nodes++;
+
+	if(depthLeft <= 0 || turnIndex >= turns.size() || state.battleIsFinished())
+		return evaluate(state);
+
+	const ui64 key = hashState(state, turnIndex);
+
+	auto entry = ctx.table.find(key);
+	if(entry != ctx.table.end() && entry->second.depth >= depthLeft)
+	{
+		const TableEntry & stored = entry->second;
+
+		if(stored.bound == EBound::EXACT)
+			return stored.value;
+		else if(stored.bound == EBound::LOWER)
+			vstd::amax(alpha, stored.value);
+		else
+			vstd::amin(beta, stored.value);
+
+		if(alpha >= beta)
+			return stored.value;
+	}
+
+	const Turn & turn = turns[turnIndex];
+
+	HypotheticBattle turnState(state);
+
+	if(turn.newRound)
+		turnState.nextRound(0);
+
+	const battle::Unit * unit = turnState.battleGetUnitByID(turn.unitId);
+
+	//dead unit does not take its turn, so it does not count as ply
+	if(!unit || !unit->alive())
+		return search(turnState, turnIndex + 1, depthLeft, alpha, beta, ctx);
+
+	const bool maximizing = turnState.battleGetOwner(unit) == player;
+
+	turnState.nextTurn(unit->unitId());
+
+	PotentialTargets targets(unit, &turnState);
+
+	int64_t value;
+
+	if(targets.possibleAttacks.empty())
+	{
+		value = search(turnState, turnIndex + 1, depthLeft - 1, alpha, beta, ctx);
+	}
+	else
+	{
+		const int64_t alphaOrig = alpha;
+		const int64_t betaOrig = beta;
+
+		value = maximizing ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+
+		for(auto ap : orderedAttacks(targets.possibleAttacks, MAX_BRANCHING))
+		{
+			HypotheticBattle child(turnState);
+			ap->applyTo(&child);
+
+			const int64_t childValue = search(child, turnIndex + 1, depthLeft - 1, alpha, beta, ctx);
+
+			if(maximizing)
+			{
+				vstd::amax(value, childValue);
+				vstd::amax(alpha, value);
+			}
+			else
+			{
+				vstd::amin(value, childValue);
+				vstd::amin(beta, value);
+			}
+
+			if(alpha >= beta)
+				break;
+		}
+
+		if(ctx.timedOut)
+			return 0;
+
+		TableEntry & stored = ctx.table[key];
+		stored.depth = depthLeft;
+		stored.value = value;
+
+		if(value <= alphaOrig)
+			stored.bound = EBound::UPPER;
+		else if(value >= betaOrig)
+			stored.bound = EBound::LOWER;
+		else
+			stored.bound = EBound::EXACT;
+	}
+
+	return value;
+}
+
+int64_t BattleSearch::evaluate(const HypotheticBattle & state) const
+{
+	int64_t value = 0;
+
+	for(auto unit : state.battleGetUnitsIf([](const battle::Unit * u){ return u->alive(); }))
+	{
+		const int64_t maxHealth = std::max<int64_t>(1, unit->MaxHealth());
+		const int64_t unitValue = unit->getAvailableHealth() * unit->unitType()->AIValue / maxHealth;
+
+		if(state.battleGetOwner(unit) == player)
+			value += unitValue;
+		else
+			value -= unitValue;
+	}
+
+	return value;
+}
+
+ui64 BattleSearch::hashState(const HypotheticBattle & state, size_t turnIndex)
+{
+	ui64 key = mix(turnIndex);
+
+	for(auto unit : state.battleGetUnitsIf([](const battle::Unit * u){ return !u->isGhost(); }))
+	{
+		ui64 unitKey = mix(unit->unitId());
+		unitKey = mix(unitKey ^ static_cast<ui16>(unit->getPosition().hex));
+		unitKey = mix(unitKey ^ static_cast<ui64>(unit->getAvailableHealth()));
+
+		ui64 flags = 0;
+		flags |= unit->alive() << 0;
+		flags |= unit->moved() << 1;
+		flags |= unit->waited() << 2;
+		flags |= unit->defended() << 3;
+		flags |= unit->ableToRetaliate() << 4;
+		flags |= unit->canShoot() << 5;
+		unitKey = mix(unitKey ^ flags);
+
+		auto swb = state.stackStates.find(unit->unitId());
+		if(swb != state.stackStates.end())
+		{
+			const StackWithBonuses & changed = *swb->second;
+
+			const ui64 counts = static_cast<ui64>(changed.bonusesToAdd.size())
+				| static_cast<ui64>(changed.bonusesToUpdate.size()) << 16
+				| static_cast<ui64>(changed.bonusesToRemove.size()) << 32;
+			unitKey = mix(unitKey ^ counts);
+
+			for(auto & bonus : changed.bonusesToAdd)
+				unitKey = mix(unitKey ^ (static_cast<ui64>(bonus->type) << 32 | static_cast<ui32>(bonus->sid)));
+		}
+
+		key ^= unitKey;
+	}
+
+	return key;
+}
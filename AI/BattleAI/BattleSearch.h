@@ -0,0 +1,67 @@
+/*
+ * BattleSearch.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+#include "PotentialTargets.h"
+
+/// Looks several turns ahead to choose attack of active unit.
+/// Uses iterative deepening alpha-beta search over battle turn order, limited by wall-clock time budget.
+/// Only attacks are searched: unit that cannot attack anyone stays in place and passes its turn, so approaching
+/// enemies over several turns is not evaluated and units out of reach are valued as they stand.
+class BattleSearch
+{
+public:
+	BattleSearch(std::shared_ptr<CBattleCallback> cb_, PlayerColor player_, int timeBudgetMs);
+
+	///returns none if search could not complete even one ply in time, caller should use its own choice then
+	boost::optional<AttackPossibility> findBestAttack(const battle::Unit * active, const PotentialTargets & targets);
+
+private:
+	static const int MAX_DEPTH = 8;
+	static const size_t MAX_BRANCHING = 3; //only best attacks of each unit are considered
+
+	struct Turn
+	{
+		uint32_t unitId;
+		bool newRound;
+	};
+
+	enum class EBound
+	{
+		EXACT, LOWER, UPPER
+	};
+
+	struct TableEntry
+	{
+		int depth;
+		int64_t value;
+		EBound bound;
+	};
+
+	///search state of one root move, kept between iterations of deepening
+	struct Context
+	{
+		std::unordered_map<ui64, TableEntry> table;
+		bool timedOut = false;
+		ui64 nodes = 0;
+	};
+
+	std::shared_ptr<CBattleCallback> cb;
+	PlayerColor player;
+	std::vector<Turn> turns;
+	boost::chrono::steady_clock::time_point deadline;
+
+	int64_t search(const HypotheticBattle & state, size_t turnIndex, int depthLeft, int64_t alpha, int64_t beta, Context & ctx) const;
+
+	///value of remaining units from our point of view
+	int64_t evaluate(const HypotheticBattle & state) const;
+
+	///Zobrist-like key of unit positions, health, counters and effects, independent of order in which units were changed
+	static ui64 hashState(const HypotheticBattle & state, size_t turnIndex);
+};
@@ -12,11 +12,16 @@
 #include "../../lib/CStack.h"//todo: remove
 
 PotentialTargets::PotentialTargets(const battle::Unit * attacker, const HypotheticBattle * state)
+	: PotentialTargets(attacker, state, state->getAccesibility())
+{
+}
+
+PotentialTargets::PotentialTargets(const battle::Unit * attacker, const HypotheticBattle * state, const AccessibilityInfo & accessibility)
 {
 	auto attIter = state->stackStates.find(attacker->unitId());
 	const battle::Unit * attackerInfo = (attIter == state->stackStates.end()) ? attacker : attIter->second.get();
 
-	auto reachability = state->getReachability(attackerInfo);
+	auto reachability = state->getReachability(attackerInfo, accessibility);
 	auto avHexes = state->battleGetAvailableHexes(reachability, attackerInfo);
 
 	//FIXME: this should part of battleGetAvailableHexes
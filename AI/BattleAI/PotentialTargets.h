@@ -18,6 +18,8 @@ public:
 
 	PotentialTargets(){};
 	PotentialTargets(const battle::Unit * attacker, const HypotheticBattle * state);
+	//accessibility must be obtained from state, allows to share it with other reachability queries on unchanged state
+	PotentialTargets(const battle::Unit * attacker, const HypotheticBattle * state, const AccessibilityInfo & accessibility);
 
 	AttackPossibility bestAction() const;
 	int bestActionValue() const;
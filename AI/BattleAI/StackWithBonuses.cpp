@@ -59,6 +59,25 @@ StackWithBonuses::StackWithBonuses(const HypotheticBattle * Owner, const battle:
 	summoned = info.summoned;
 }
 
+StackWithBonuses::StackWithBonuses(const HypotheticBattle * Owner, const StackWithBonuses & other)
+	: battle::CUnitState(),
+	bonusesToAdd(other.bonusesToAdd),
+	bonusesToUpdate(other.bonusesToUpdate),
+	bonusesToRemove(other.bonusesToRemove),
+	origBearer(other.origBearer),
+	owner(Owner),
+	type(other.type),
+	baseAmount(other.baseAmount),
+	id(other.id),
+	side(other.side),
+	player(other.player),
+	slot(other.slot)
+{
+	localInit(Owner);
+
+	battle::CUnitState::operator=(other);
+}
+
 StackWithBonuses::~StackWithBonuses() = default;
 
 StackWithBonuses & StackWithBonuses::operator=(const battle::CUnitState & other)
@@ -98,10 +117,10 @@ SlotID StackWithBonuses::unitSlot() const
 }
 
 const TBonusListPtr StackWithBonuses::getAllBonuses(const CSelector & selector, const CSelector & limit,
-	const CBonusSystemNode * root, const std::string & cachingStr) const
+	const CBonusSystemNode * root, const BonusCacheKey & cachingKey) const
 {
 	TBonusListPtr ret = std::make_shared<BonusList>();
-	const TBonusListPtr originalList = origBearer->getAllBonuses(selector, limit, root, cachingStr);
+	const TBonusListPtr originalList = origBearer->getAllBonuses(selector, limit, root, cachingKey);
 
 	vstd::copy_if(*originalList, std::back_inserter(*ret), [this](const std::shared_ptr<Bonus> & b)
 	{
@@ -127,9 +146,8 @@ const TBonusListPtr StackWithBonuses::getAllBonuses(const CSelector & selector,
 
 	for(auto & bonus : bonusesToAdd)
 	{
-		auto b = std::make_shared<Bonus>(bonus);
-		if(selector(b.get()) && (!limit || !limit(b.get())))
-			ret->push_back(b);
+		if(selector(bonus.get()) && (!limit || !limit(bonus.get())))
+			ret->push_back(bonus);
 	}
 	//TODO limiters?
 	return ret;
@@ -137,12 +155,14 @@ const TBonusListPtr StackWithBonuses::getAllBonuses(const CSelector & selector,
 
 int64_t StackWithBonuses::getTreeVersion() const
 {
-	return owner->getTreeVersion();
+	//original bearer is not necessarily a descendant of battle node (f.e. summoned creature type)
+	return origBearer->getTreeVersion() + owner->getTreeVersion();
 }
 
 void StackWithBonuses::addUnitBonus(const std::vector<Bonus> & bonus)
 {
-	vstd::concatenate(bonusesToAdd, bonus);
+	for(auto & one : bonus)
+		bonusesToAdd.push_back(std::make_shared<Bonus>(one));
 }
 
 void StackWithBonuses::updateUnitBonus(const std::vector<Bonus> & bonus)
@@ -182,7 +202,7 @@ void StackWithBonuses::removeUnitBonus(const CSelector & selector)
 	for(auto b : *toRemove)
 		bonusesToRemove.insert(b);
 
-	vstd::erase_if(bonusesToAdd, [&](const Bonus & b){return selector(&b);});
+	vstd::erase_if(bonusesToAdd, [&](const std::shared_ptr<Bonus> & b){return selector(b.get());});
 	vstd::erase_if(bonusesToUpdate, [&](const Bonus & b){return selector(&b);});
 }
 
@@ -191,6 +211,11 @@ void StackWithBonuses::spendMana(const spells::PacketSender * server, const int
 	//TODO: evaluate cast use
 }
 
+bool StackWithBonuses::isOwnedBy(const HypotheticBattle * battle) const
+{
+	return owner == battle;
+}
+
 HypotheticBattle::HypotheticBattle(Subject realBattle)
 	: BattleProxy(realBattle),
 	bonusTreeVersion(1)
@@ -201,6 +226,16 @@ HypotheticBattle::HypotheticBattle(Subject realBattle)
 	nextId = 0xF0000000;
 }
 
+HypotheticBattle::HypotheticBattle(const HypotheticBattle & parent)
+	: CCallbackBase(),
+	BattleProxy(parent.subject),
+	stackStates(parent.stackStates),
+	bonusTreeVersion(parent.bonusTreeVersion),
+	activeUnitId(parent.activeUnitId),
+	nextId(parent.nextId)
+{
+}
+
 bool HypotheticBattle::unitHasAmmoCart(const battle::Unit * unit) const
 {
 	//FIXME: check ammocart alive state here
@@ -224,6 +259,12 @@ std::shared_ptr<StackWithBonuses> HypotheticBattle::getForUpdate(uint32_t id)
 		stackStates[id] = ret;
 		return ret;
 	}
+	else if(!iter->second->isOwnedBy(this))
+	{
+		//state is shared with parent battle, copy on first change
+		iter->second = std::make_shared<StackWithBonuses>(this, *iter->second);
+		return iter->second;
+	}
 	else
 	{
 		return iter->second;
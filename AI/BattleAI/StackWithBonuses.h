@@ -19,7 +19,7 @@ class StackWithBonuses : public battle::CUnitState, public virtual IBonusBearer
 {
 public:
 
-	std::vector<Bonus> bonusesToAdd;
+	std::vector<std::shared_ptr<Bonus>> bonusesToAdd; //never modified after adding, so may be shared between copies of unit
 	std::vector<Bonus> bonusesToUpdate;
 	std::set<std::shared_ptr<Bonus>> bonusesToRemove;
 
@@ -27,6 +27,9 @@ public:
 
 	StackWithBonuses(const HypotheticBattle * Owner, const battle::UnitInfo & info);
 
+	///copy of unit state from another hypothetic battle
+	StackWithBonuses(const HypotheticBattle * Owner, const StackWithBonuses & other);
+
 	virtual ~StackWithBonuses();
 
 	StackWithBonuses & operator= (const battle::CUnitState & other);
@@ -43,7 +46,7 @@ public:
 
 	///IBonusBearer
 	const TBonusListPtr getAllBonuses(const CSelector & selector, const CSelector & limit,
-		const CBonusSystemNode * root = nullptr, const std::string & cachingStr = "") const override;
+		const CBonusSystemNode * root = nullptr, const BonusCacheKey & cachingKey = BonusCacheKey()) const override;
 
 	int64_t getTreeVersion() const override;
 
@@ -55,6 +58,8 @@ public:
 
 	void spendMana(const spells::PacketSender * server, const int spellCost) const override;
 
+	bool isOwnedBy(const HypotheticBattle * battle) const;
+
 private:
 	const IBonusBearer * origBearer;
 	const HypotheticBattle * owner;
@@ -74,9 +79,14 @@ public:
 
 	HypotheticBattle(Subject realBattle);
 
+	///creates branch of another hypothetic battle, parent must outlive its branches and must not be changed while they exist
+	///unit states are shared with parent and copied only when changed in this branch
+	HypotheticBattle(const HypotheticBattle & parent);
+
 	bool unitHasAmmoCart(const battle::Unit * unit) const override;
 	PlayerColor unitEffectiveOwner(const battle::Unit * unit) const override;
 
+	///returns state of unit owned by this battle, copying it from real battle or from parent if needed
 	std::shared_ptr<StackWithBonuses> getForUpdate(uint32_t id);
 
 	int32_t getActiveStackID() const override;
@@ -27,6 +27,9 @@ ThreatMap::ThreatMap(const CStack *Endangered) : endangered(Endangered)
 {
 	sufferedDamage.fill(0);
 
+	//battle state does not change while threats are computed
+	const AccessibilityInfo accessibility = getCbc()->getAccesibility();
+
 	for(const CStack *enemy : getCbc()->battleGetStacks())
 	{
 		//Consider only stacks of different owner
@@ -36,7 +39,7 @@ ThreatMap::ThreatMap(const CStack *Endangered) : endangered(Endangered)
 		//Look-up which tiles can be melee-attacked
 		std::array<bool, GameConstants::BFIELD_SIZE> meleeAttackable;
 		meleeAttackable.fill(false);
-		auto enemyReachability = getCbc()->getReachability(enemy);
+		auto enemyReachability = getCbc()->getReachability(enemy, accessibility);
 		for(int i = 0; i < GameConstants::BFIELD_SIZE; i++)
 		{
 			if(enemyReachability.isReachable(i))
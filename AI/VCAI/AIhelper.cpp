@@ -154,6 +154,16 @@ void AIhelper::updatePaths(std::vector<HeroPtr> heroes)
 	pathfindingManager->updatePaths(heroes);
 }
 
+void AIhelper::invalidatePaths(const std::vector<int3> & changedTiles)
+{
+	pathfindingManager->invalidatePaths(changedTiles);
+}
+
+void AIhelper::invalidateAllPaths()
+{
+	pathfindingManager->invalidateAllPaths();
+}
+
 bool AIhelper::canGetArmy(const CArmedInstance * army, const CArmedInstance * source) const
 {
 	return armyManager->canGetArmy(army, source);
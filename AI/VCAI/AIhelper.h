@@ -63,6 +63,8 @@ public:
 	Goals::TGoalVec howToVisitObj(ObjectIdRef obj) const override;
 	std::vector<AIPath> getPathsToTile(const HeroPtr & hero, const int3 & tile) const override;
 	void updatePaths(std::vector<HeroPtr> heroes) override;
+	void invalidatePaths(const std::vector<int3> & changedTiles) override;
+	void invalidateAllPaths() override;
 
 	STRONG_INLINE
 	bool isTileAccessible(const HeroPtr & hero, const int3 & tile) const
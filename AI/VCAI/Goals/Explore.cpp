@@ -63,7 +63,7 @@ namespace Goals
 				{
 					int3 tile = int3(x, y, ourPos.z);
 
-					if(cbp->isInTheMap(tile) && ts->fogOfWarMap[tile.x][tile.y][tile.z])
+					if(cbp->isInTheMap(tile) && ts->fogOfWarMap.isVisible(tile))
 					{
 						scanTile(tile);
 					}
@@ -84,13 +84,13 @@ namespace Goals
 
 			foreach_tile_pos([&](const int3 & pos)
 			{
-				if(ts->fogOfWarMap[pos.x][pos.y][pos.z])
+				if(ts->fogOfWarMap.isVisible(pos))
 				{
 					bool hasInvisibleNeighbor = false;
 
 					foreach_neighbour(cbp, pos, [&](CCallback * cbp, int3 neighbour)
 					{
-						if(!ts->fogOfWarMap[neighbour.x][neighbour.y][neighbour.z])
+						if(!ts->fogOfWarMap.isVisible(neighbour))
 						{
 							hasInvisibleNeighbor = true;
 						}
@@ -174,7 +174,7 @@ namespace Goals
 			{
 				foreach_neighbour(cbp, tile, [&](CCallback * cbp, int3 neighbour)
 				{
-					if(ts->fogOfWarMap[neighbour.x][neighbour.y][neighbour.z])
+					if(ts->fogOfWarMap.isVisible(neighbour))
 					{
 						out.push_back(neighbour);
 					}
@@ -193,7 +193,7 @@ namespace Goals
 					int3 npos = int3(x, y, pos.z);
 					if(cbp->isInTheMap(npos)
 						&& pos.dist2d(npos) - 0.5 < sightRadius
-						&& !ts->fogOfWarMap[npos.x][npos.y][npos.z])
+						&& !ts->fogOfWarMap.isVisible(npos))
 					{
 						if(allowDeadEndCancellation
 							&& !hasReachableNeighbor(npos))
@@ -18,58 +18,138 @@
 #include "../../../lib/CPlayerState.h"
 
 AINodeStorage::AINodeStorage(const int3 & Sizes)
-	: sizes(Sizes)
+	: sizes(Sizes), calculation(0), gs(nullptr), fow(nullptr), useFlying(false), useWaterWalking(false)
 {
-	nodes.resize(boost::extents[sizes.x][sizes.y][sizes.z][EPathfindingLayer::NUM_LAYERS][NUM_CHAINS]);
+	regionCounts = int3(
+		(sizes.x + REGION_SIZE - 1) / REGION_SIZE,
+		(sizes.y + REGION_SIZE - 1) / REGION_SIZE,
+		sizes.z);
+
+	regions.resize(regionCounts.x * regionCounts.y * regionCounts.z);
 	dangerEvaluator.reset(new FuzzyHelper());
 }
 
 AINodeStorage::~AINodeStorage() = default;
 
+AINodeStorage::HeroState::HeroState(const CGHeroInstance * hero)
+	: hero(hero), movement(0), mana(0), inBoat(false), bonusVersion(0), spellsCount(0)
+{
+	if(hero)
+	{
+		position = hero->getPosition(false);
+		movement = hero->movement;
+		mana = hero->mana;
+		inBoat = hero->boat != nullptr;
+		bonusVersion = hero->getTreeVersion();
+		spellsCount = hero->getSpellsInSpellbook().size();
+
+		for(auto & slot : hero->Slots())
+			army.push_back(std::make_pair(slot.second->getCreatureID(), slot.second->count));
+	}
+}
+
+bool AINodeStorage::HeroState::operator==(const HeroState & other) const
+{
+	return hero == other.hero
+		&& position == other.position
+		&& movement == other.movement
+		&& mana == other.mana
+		&& inBoat == other.inBoat
+		&& bonusVersion == other.bonusVersion
+		&& spellsCount == other.spellsCount
+		&& army == other.army;
+}
+
 void AINodeStorage::initialize(const PathfinderOptions & options, const CGameState * gs, const CGHeroInstance * hero)
+{
+	calculatedFor = HeroState(hero);
+
+	// regions are initialized on demand, see initializeRegion
+	calculation++;
+	this->gs = gs;
+	fow = &static_cast<const CGameInfoCallback *>(gs)->getPlayerTeam(hero->tempOwner)->fogOfWarMap;
+	player = hero->tempOwner;
+	useFlying = options.useFlying;
+	useWaterWalking = options.useWaterWalking;
+}
+
+void AINodeStorage::initializeRegion(Region & region, const int3 & origin)
 {
 	//TODO: fix this code duplication with NodeStorage::initialize, problem is to keep `resetTile` inline
 
 	int3 pos;
-	const int3 sizes = gs->getMapSize();
-	const auto & fow = static_cast<const CGameInfoCallback *>(gs)->getPlayerTeam(hero->tempOwner)->fogOfWarMap;
-	const PlayerColor player = hero->tempOwner;
+	const int3 end(std::min(origin.x + REGION_SIZE, sizes.x), std::min(origin.y + REGION_SIZE, sizes.y), origin.z);
 
-	//make 200% sure that these are loop invariants (also a bit shorter code), let compiler do the rest(loop unswitching)
-	const bool useFlying = options.useFlying;
-	const bool useWaterWalking = options.useWaterWalking;
+	region.calculation = calculation;
 
-	for(pos.x=0; pos.x < sizes.x; ++pos.x)
+	for(pos.x = origin.x; pos.x < end.x; ++pos.x)
 	{
-		for(pos.y=0; pos.y < sizes.y; ++pos.y)
+		for(pos.y = origin.y; pos.y < end.y; ++pos.y)
 		{
-			for(pos.z=0; pos.z < sizes.z; ++pos.z)
+			pos.z = origin.z;
+
+			auto layerChains = [&](EPathfindingLayer layer) -> AIPathNode *
 			{
-				const TerrainTile * tile = &gs->map->getTile(pos);
-				switch(tile->terType)
-				{
-				case ETerrainType::ROCK:
-					break;
-
-				case ETerrainType::WATER:
-					resetTile(pos, ELayer::SAIL, PathfinderUtil::evaluateAccessibility<ELayer::SAIL>(pos, tile, fow, player, gs));
-					if(useFlying)
-						resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
-					if(useWaterWalking)
-						resetTile(pos, ELayer::WATER, PathfinderUtil::evaluateAccessibility<ELayer::WATER>(pos, tile, fow, player, gs));
-					break;
-
-				default:
-					resetTile(pos, ELayer::LAND, PathfinderUtil::evaluateAccessibility<ELayer::LAND>(pos, tile, fow, player, gs));
-					if(useFlying)
-						resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
-					break;
-				}
+				return &region.nodes[(((pos.y - origin.y) * REGION_SIZE + pos.x - origin.x) * EPathfindingLayer::NUM_LAYERS + layer) * NUM_CHAINS];
+			};
+
+			for(EPathfindingLayer layer = EPathfindingLayer::LAND; layer < EPathfindingLayer::NUM_LAYERS; layer.advance(1))
+				resetTile(layerChains(layer), pos, layer, CGPathNode::NOT_SET);
+
+			const TerrainTile * tile = &gs->map->getTile(pos);
+			switch(tile->terType)
+			{
+			case ETerrainType::ROCK:
+				break;
+
+			case ETerrainType::WATER:
+				resetTile(layerChains(ELayer::SAIL), pos, ELayer::SAIL, PathfinderUtil::evaluateAccessibility<ELayer::SAIL>(pos, tile, *fow, player, gs));
+				if(useFlying)
+					resetTile(layerChains(ELayer::AIR), pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, *fow, player, gs));
+				if(useWaterWalking)
+					resetTile(layerChains(ELayer::WATER), pos, ELayer::WATER, PathfinderUtil::evaluateAccessibility<ELayer::WATER>(pos, tile, *fow, player, gs));
+				break;
+
+			default:
+				resetTile(layerChains(ELayer::LAND), pos, ELayer::LAND, PathfinderUtil::evaluateAccessibility<ELayer::LAND>(pos, tile, *fow, player, gs));
+				if(useFlying)
+					resetTile(layerChains(ELayer::AIR), pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, *fow, player, gs));
+				break;
 			}
 		}
 	}
 }
 
+const AIPathNode * AINodeStorage::getChains(const int3 & pos, EPathfindingLayer layer) const
+{
+	const int3 regionPos(pos.x / REGION_SIZE, pos.y / REGION_SIZE, pos.z);
+	const Region * region = regions[(regionPos.z * regionCounts.y + regionPos.y) * regionCounts.x + regionPos.x].get();
+
+	if(!region || region->calculation != calculation)
+		return nullptr;
+
+	const int3 local(pos.x % REGION_SIZE, pos.y % REGION_SIZE, 0);
+
+	return &region->nodes[((local.y * REGION_SIZE + local.x) * EPathfindingLayer::NUM_LAYERS + layer) * NUM_CHAINS];
+}
+
+AIPathNode * AINodeStorage::getOrInitChains(const int3 & pos, EPathfindingLayer layer)
+{
+	const int3 regionPos(pos.x / REGION_SIZE, pos.y / REGION_SIZE, pos.z);
+	auto & region = regions[(regionPos.z * regionCounts.y + regionPos.y) * regionCounts.x + regionPos.x];
+
+	if(!region)
+	{
+		region = make_unique<Region>();
+		region->calculation = 0;
+	}
+
+	if(region->calculation != calculation)
+		initializeRegion(*region, int3(regionPos.x * REGION_SIZE, regionPos.y * REGION_SIZE, pos.z));
+
+	return const_cast<AIPathNode *>(getChains(pos, layer));
+}
+
 const AIPathNode * AINodeStorage::getAINode(const CGPathNode * node) const
 {
 	return static_cast<const AIPathNode *>(node);
@@ -89,10 +169,12 @@ bool AINodeStorage::isBattleNode(const CGPathNode * node) const
 
 boost::optional<AIPathNode *> AINodeStorage::getOrCreateNode(const int3 & pos, const EPathfindingLayer layer, int chainNumber)
 {
-	auto chains = nodes[pos.x][pos.y][pos.z][layer];
+	AIPathNode * chains = getOrInitChains(pos, layer);
 
-	for(AIPathNode & node : chains)
+	for(int i = 0; i < NUM_CHAINS; i++)
 	{
+		AIPathNode & node = chains[i];
+
 		if(node.chainMask == chainNumber)
 		{
 			return &node;
@@ -124,11 +206,11 @@ CGPathNode * AINodeStorage::getInitialNode()
 	return initialNode;
 }
 
-void AINodeStorage::resetTile(const int3 & coord, EPathfindingLayer layer, CGPathNode::EAccessibility accessibility)
+void AINodeStorage::resetTile(AIPathNode * chains, const int3 & coord, EPathfindingLayer layer, CGPathNode::EAccessibility accessibility)
 {
 	for(int i = 0; i < NUM_CHAINS; i++)
 	{
-		AIPathNode & heroNode = nodes[coord.x][coord.y][coord.z][layer][i];
+		AIPathNode & heroNode = chains[i];
 
 		heroNode.chainMask = 0;
 		heroNode.danger = 0;
@@ -192,6 +274,42 @@ void AINodeStorage::setHero(HeroPtr heroPtr, const VCAI * _ai)
 	ai = _ai;
 }
 
+bool AINodeStorage::isCalculatedFor(const CGHeroInstance * hero) const
+{
+	return calculatedFor == HeroState(hero);
+}
+
+bool AINodeStorage::isAffectedByTile(const int3 & tile) const
+{
+	for(int dx = -1; dx <= 1; dx++)
+	{
+		for(int dy = -1; dy <= 1; dy++)
+		{
+			int3 pos = tile + int3(dx, dy, 0);
+
+			if(pos.x < 0 || pos.y < 0 || pos.z < 0 || pos.x >= sizes.x || pos.y >= sizes.y || pos.z >= sizes.z)
+				continue;
+
+			for(EPathfindingLayer layer = EPathfindingLayer::LAND; layer < EPathfindingLayer::NUM_LAYERS; layer.advance(1))
+			{
+				const AIPathNode * chains = getChains(pos, layer);
+
+				if(!chains)
+					break; //region was not reached at all
+
+				for(int i = 0; i < NUM_CHAINS; i++)
+				{
+					//nodes are created for every tile search tried to enter
+					if(chains[i].chainMask)
+						return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
 std::vector<CGPathNode *> AINodeStorage::calculateTeleportations(
 	const PathNodeInfo & source,
 	const PathfinderConfig * pathfinderConfig,
@@ -292,11 +410,15 @@ void AINodeStorage::calculateTownPortalTeleportations(
 bool AINodeStorage::hasBetterChain(const PathNodeInfo & source, CDestinationNodeInfo & destination) const
 {
 	auto pos = destination.coord;
-	auto chains = nodes[pos.x][pos.y][pos.z][EPathfindingLayer::LAND];
+	const AIPathNode * chains = getChains(pos, EPathfindingLayer::LAND);
 	auto destinationNode = getAINode(destination.node);
 
-	for(const AIPathNode & node : chains)
+	if(!chains)
+		return false;
+
+	for(int i = 0; i < NUM_CHAINS; i++)
 	{
+		const AIPathNode & node = chains[i];
 		auto sameNode = node.chainMask == destinationNode->chainMask;
 		if(sameNode	|| node.action == CGPathNode::ENodeAction::UNKNOWN)
 		{
@@ -312,7 +434,7 @@ bool AINodeStorage::hasBetterChain(const PathNodeInfo & source, CDestinationNode
 					"Block ineficient move %s:->%s, mask=%i, mp diff: %i",
 					source.coord.toString(),
 					destination.coord.toString(),
-					destinationNode->chainMask,
+					(int)destinationNode->chainMask,
 					node.moveRemains - destinationNode->moveRemains);
 #endif
 				return true;
@@ -325,19 +447,24 @@ bool AINodeStorage::hasBetterChain(const PathNodeInfo & source, CDestinationNode
 
 bool AINodeStorage::isTileAccessible(const int3 & pos, const EPathfindingLayer layer) const
 {
-	const AIPathNode & node = nodes[pos.x][pos.y][pos.z][layer][0];
+	const AIPathNode * chains = getChains(pos, layer);
 
-	return node.action != CGPathNode::ENodeAction::UNKNOWN;
+	return chains && chains[0].action != CGPathNode::ENodeAction::UNKNOWN;
 }
 
 std::vector<AIPath> AINodeStorage::getChainInfo(const int3 & pos, bool isOnLand) const
 {
 	std::vector<AIPath> paths;
-	auto chains = nodes[pos.x][pos.y][pos.z][isOnLand ? EPathfindingLayer::LAND : EPathfindingLayer::SAIL];
+	const AIPathNode * chains = getChains(pos, isOnLand ? EPathfindingLayer::LAND : EPathfindingLayer::SAIL);
 	auto initialPos = hero->visitablePos();
 
-	for(const AIPathNode & node : chains)
+	if(!chains)
+		return paths;
+
+	for(int i = 0; i < NUM_CHAINS; i++)
 	{
+		const AIPathNode & node = chains[i];
+
 		if(node.action == CGPathNode::ENodeAction::UNKNOWN)
 		{
 			continue;
@@ -21,9 +21,10 @@ struct AIPathNode;
 
 struct AIPathNode : public CGPathNode
 {
-	uint32_t chainMask;
-	uint64_t danger;
+	// chainMask fits into tail padding of CGPathNode, keep narrow fields first
+	uint8_t chainMask;
 	uint32_t manaCost;
+	uint64_t danger;
 	std::shared_ptr<const ISpecialAction> specialAction;
 };
 
@@ -57,17 +58,52 @@ struct AIPath
 class AINodeStorage : public INodeStorage
 {
 private:
+	/// State of the hero that affects calculated paths
+	struct HeroState
+	{
+		const CGHeroInstance * hero;
+		int3 position;
+		ui32 movement;
+		si32 mana;
+		bool inBoat;
+		int64_t bonusVersion;
+		size_t spellsCount;
+		std::vector<std::pair<CreatureID, TQuantity>> army; //danger of the path depends on army strength
+
+		HeroState(const CGHeroInstance * hero = nullptr);
+		bool operator==(const HeroState & other) const;
+	};
+
+	struct Region;
+
 	int3 sizes;
+	int3 regionCounts; //number of regions along each axis
+	HeroState calculatedFor; //state of the hero at the time paths were calculated
+
+	/// Nodes grouped in square regions of the map, allocated when path search enters the region for the first time
+	std::vector<std::unique_ptr<Region>> regions;
+	int calculation; //number of current calculation, regions initialized for older ones are treated as not reached
+
+	// parameters of current calculation, needed to initialize regions
+	const CGameState * gs;
+	const FogOfWarMap * fow;
+	PlayerColor player;
+	bool useFlying;
+	bool useWaterWalking;
 
-	/// 1-3 - position on map, 4 - layer (air, water, land), 5 - chain (normal, battle, spellcast and combinations)
-	boost::multi_array<AIPathNode, 5> nodes;
 	const CPlayerSpecificInfoCallback * cb;
 	const VCAI * ai;
 	const CGHeroInstance * hero;
 	std::unique_ptr<FuzzyHelper> dangerEvaluator;
 
 	STRONG_INLINE
-	void resetTile(const int3 & tile, EPathfindingLayer layer, CGPathNode::EAccessibility accessibility);
+	void resetTile(AIPathNode * chains, const int3 & tile, EPathfindingLayer layer, CGPathNode::EAccessibility accessibility);
+
+	/// Returns NUM_CHAINS nodes of given tile and layer, nullptr if current calculation did not reach this part of the map
+	const AIPathNode * getChains(const int3 & pos, EPathfindingLayer layer) const;
+	/// Same as getChains, but allocates and initializes nodes of the region if needed
+	AIPathNode * getOrInitChains(const int3 & pos, EPathfindingLayer layer);
+	void initializeRegion(Region & region, const int3 & origin);
 
 public:
 	/// more than 1 chain layer allows us to have more than 1 path to each tile so we can chose more optimal one.
@@ -79,6 +115,8 @@ public:
 	static const int CAST_CHAIN = 4;
 	static const int RESOURCE_CHAIN = 8;
 
+	static const int REGION_SIZE = 8; //regions are REGION_SIZE x REGION_SIZE tiles
+
 	AINodeStorage(const int3 & sizes);
 	~AINodeStorage();
 
@@ -109,6 +147,11 @@ public:
 
 	void setHero(HeroPtr heroPtr, const VCAI * ai);
 
+	/// True if stored paths were calculated for given hero in his current state
+	bool isCalculatedFor(const CGHeroInstance * hero) const;
+	/// True if change of given tile may change stored paths, i.e. search reached the tile or one of its neighbours
+	bool isAffectedByTile(const int3 & tile) const;
+
 	const CGHeroInstance * getHero() const
 	{
 		return hero;
@@ -120,5 +163,12 @@ public:
 	}
 
 private:
+	struct Region
+	{
+		int calculation;
+		/// 1-2 - position within region, 3 - layer (air, water, land), 4 - chain (normal, battle, spellcast and combinations)
+		std::array<AIPathNode, REGION_SIZE * REGION_SIZE * EPathfindingLayer::NUM_LAYERS * NUM_CHAINS> nodes;
+	};
+
 	void calculateTownPortalTeleportations(const PathNodeInfo & source, std::vector<CGPathNode *> & neighbours);
 };
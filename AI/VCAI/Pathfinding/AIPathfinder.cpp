@@ -17,7 +17,7 @@ std::vector<std::shared_ptr<AINodeStorage>> AIPathfinder::storagePool;
 std::map<HeroPtr, std::shared_ptr<AINodeStorage>> AIPathfinder::storageMap;
 
 AIPathfinder::AIPathfinder(CPlayerSpecificInfoCallback * cb, VCAI * ai)
-	:cb(cb), ai(ai)
+	:cb(cb), ai(ai), allTilesChanged(true)
 {
 }
 
@@ -25,6 +25,20 @@ void AIPathfinder::init()
 {
 	storagePool.clear();
 	storageMap.clear();
+	invalidateAllPaths();
+}
+
+void AIPathfinder::invalidatePaths(const std::vector<int3> & tiles)
+{
+	boost::unique_lock<boost::mutex> lock(changesMutex);
+	vstd::concatenate(changedTiles, tiles);
+}
+
+void AIPathfinder::invalidateAllPaths()
+{
+	boost::unique_lock<boost::mutex> lock(changesMutex);
+	changedTiles.clear();
+	allTilesChanged = true;
 }
 
 bool AIPathfinder::isTileAccessible(const HeroPtr & hero, const int3 & tile) const
@@ -51,7 +65,57 @@ std::vector<AIPath> AIPathfinder::getPathInfo(const HeroPtr & hero, const int3 &
 
 void AIPathfinder::updatePaths(std::vector<HeroPtr> heroes)
 {
-	storageMap.clear();
+	std::vector<int3> tiles;
+	bool allChanged;
+
+	{
+		boost::unique_lock<boost::mutex> lock(changesMutex);
+		tiles.swap(changedTiles);
+		allChanged = allTilesChanged;
+		allTilesChanged = false;
+	}
+
+	auto isUpToDate = [&](std::shared_ptr<AINodeStorage> nodeStorage, const CGHeroInstance * hero) -> bool
+	{
+		if(allChanged || !nodeStorage->isCalculatedFor(hero))
+			return false;
+
+		for(const int3 & tile : tiles)
+		{
+			if(nodeStorage->isAffectedByTile(tile))
+				return false;
+		}
+
+		return true;
+	};
+
+	std::map<HeroPtr, std::shared_ptr<AINodeStorage>> previousStorageMap;
+	std::vector<HeroPtr> heroesToUpdate;
+
+	previousStorageMap.swap(storageMap);
+
+	for(HeroPtr hero : heroes)
+	{
+		auto previous = previousStorageMap.find(hero);
+
+		if(previous != previousStorageMap.end() && isUpToDate(previous->second, hero.get()))
+			storageMap[hero] = previous->second;
+		else
+			heroesToUpdate.push_back(hero);
+	}
+
+	std::vector<std::shared_ptr<AINodeStorage>> freeStorages;
+
+	for(auto nodeStorage : storagePool)
+	{
+		bool used = vstd::contains_if(storageMap, [&](const std::pair<const HeroPtr, std::shared_ptr<AINodeStorage>> & entry) -> bool
+		{
+			return entry.second == nodeStorage;
+		});
+
+		if(!used)
+			freeStorages.push_back(nodeStorage);
+	}
 
 	auto calculatePaths = [&](const CGHeroInstance * hero, std::shared_ptr<AIPathfinding::AIPathfinderConfig> config)
 	{
@@ -62,13 +126,14 @@ void AIPathfinder::updatePaths(std::vector<HeroPtr> heroes)
 
 	std::vector<Task> calculationTasks;
 
-	for(HeroPtr hero : heroes)
+	for(HeroPtr hero : heroesToUpdate)
 	{
 		std::shared_ptr<AINodeStorage> nodeStorage;
 
-		if(storageMap.size() < storagePool.size())
+		if(!freeStorages.empty())
 		{
-			nodeStorage = storagePool.at(storageMap.size());
+			nodeStorage = freeStorages.back();
+			freeStorages.pop_back();
 		}
 		else
 		{
@@ -84,23 +149,7 @@ void AIPathfinder::updatePaths(std::vector<HeroPtr> heroes)
 		calculationTasks.push_back(std::bind(calculatePaths, hero.get(), config));
 	}
 
-	int threadsCount = std::min(
-		boost::thread::hardware_concurrency(),
-		(uint32_t)calculationTasks.size());
-
-	if(threadsCount <= 1)
-	{
-		for(auto task : calculationTasks)
-		{
-			task();
-		}
-	}
-	else
-	{
-		CThreadHelper helper(&calculationTasks, threadsCount);
-
-		helper.run();
-	}
+	CThreadPool::get().run(calculationTasks);
 }
 
 std::shared_ptr<const AINodeStorage> AIPathfinder::getStorage(const HeroPtr & hero) const
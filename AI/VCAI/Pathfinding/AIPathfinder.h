@@ -22,11 +22,18 @@ private:
 	CPlayerSpecificInfoCallback * cb;
 	VCAI * ai;
 
+	boost::mutex changesMutex; //changes are reported from network thread
+	std::vector<int3> changedTiles; //tiles changed since last updatePaths
+	bool allTilesChanged;
+
 	std::shared_ptr<const AINodeStorage> getStorage(const HeroPtr & hero) const;
 public:
 	AIPathfinder(CPlayerSpecificInfoCallback * cb, VCAI * ai);
 	std::vector<AIPath> getPathInfo(const HeroPtr & hero, const int3 & tile) const;
 	bool isTileAccessible(const HeroPtr & hero, const int3 & tile) const;
+	/// Recalculates paths of heroes that moved or whose search reached any tile changed since last update
 	void updatePaths(std::vector<HeroPtr> heroes);
+	void invalidatePaths(const std::vector<int3> & tiles);
+	void invalidateAllPaths();
 	void init();
 };
@@ -237,6 +237,16 @@ Goals::TSubgoal PathfindingManager::clearWayTo(HeroPtr hero, int3 firstTileToGet
 
 void PathfindingManager::updatePaths(std::vector<HeroPtr> heroes)
 {
-	logAi->debug("AIPathfinder has been reseted.");
+	logAi->debug("Updating AI paths.");
 	pathfinder->updatePaths(heroes);
 }
+
+void PathfindingManager::invalidatePaths(const std::vector<int3> & changedTiles)
+{
+	pathfinder->invalidatePaths(changedTiles);
+}
+
+void PathfindingManager::invalidateAllPaths()
+{
+	pathfinder->invalidateAllPaths();
+}
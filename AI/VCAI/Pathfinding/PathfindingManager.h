@@ -21,6 +21,8 @@ public:
 	virtual void setAI(VCAI * AI) = 0;
 
 	virtual void updatePaths(std::vector<HeroPtr> heroes) = 0;
+	virtual void invalidatePaths(const std::vector<int3> & changedTiles) = 0;
+	virtual void invalidateAllPaths() = 0;
 	virtual Goals::TGoalVec howToVisitTile(const HeroPtr & hero, const int3 & tile, bool allowGatherArmy = true) const = 0;
 	virtual Goals::TGoalVec howToVisitObj(const HeroPtr & hero, ObjectIdRef obj, bool allowGatherArmy = true) const = 0;
 	virtual Goals::TGoalVec howToVisitTile(const int3 & tile) const = 0;
@@ -47,6 +49,8 @@ public:
 	Goals::TGoalVec howToVisitObj(ObjectIdRef obj) const override;
 	std::vector<AIPath> getPathsToTile(const HeroPtr & hero, const int3 & tile) const override;
 	void updatePaths(std::vector<HeroPtr> heroes) override;
+	void invalidatePaths(const std::vector<int3> & changedTiles) override;
+	void invalidateAllPaths() override;
 
 	STRONG_INLINE
 	bool isTileAccessible(const HeroPtr & hero, const int3 & tile) const
@@ -99,6 +99,7 @@ void VCAI::heroMoved(const TryMoveHero & details)
 
 	const int3 from = CGHeroInstance::convertPosition(details.start, false);
 	const int3 to = CGHeroInstance::convertPosition(details.end, false);
+	ah->invalidatePaths({from, to});
 	const CGObjectInstance * o1 = vstd::frontOrNull(cb->getVisitableObjs(from));
 	const CGObjectInstance * o2 = vstd::frontOrNull(cb->getVisitableObjs(to));
 
@@ -139,6 +140,7 @@ void VCAI::heroInGarrisonChange(const CGTownInstance * town)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+	ah->invalidateAllPaths();
 }
 
 void VCAI::centerView(int3 pos, int focusTime)
@@ -274,19 +276,29 @@ void VCAI::tileHidden(const std::unordered_set<int3, ShashInt3> & pos)
 
 	validateVisitableObjs();
 	clearPathsInfo();
+	ah->invalidatePaths(std::vector<int3>(pos.begin(), pos.end()));
 }
 
 void VCAI::tileRevealed(const std::unordered_set<int3, ShashInt3> & pos)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+	bool teleportRevealed = false;
 	for(int3 tile : pos)
 	{
 		for(const CGObjectInstance * obj : myCb->getVisitableObjs(tile))
+		{
 			addVisitableObj(obj);
+			//teleport exit makes distant tiles reachable
+			teleportRevealed |= dynamic_cast<const CGTeleport *>(obj) != nullptr;
+		}
 	}
 
 	clearPathsInfo();
+	if(teleportRevealed)
+		ah->invalidateAllPaths();
+	else
+		ah->invalidatePaths(std::vector<int3>(pos.begin(), pos.end()));
 }
 
 void VCAI::heroExchangeStarted(ObjectInstanceID hero1, ObjectInstanceID hero2, QueryID query)
@@ -367,6 +379,7 @@ void VCAI::garrisonsChanged(ObjectInstanceID id1, ObjectInstanceID id2)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+	ah->invalidateAllPaths();
 }
 
 void VCAI::newObject(const CGObjectInstance * obj)
@@ -375,6 +388,7 @@ void VCAI::newObject(const CGObjectInstance * obj)
 	NET_EVENT_HANDLER;
 	if(obj->isVisitable())
 		addVisitableObj(obj);
+	invalidatePathsAround(obj);
 }
 
 //to prevent AI from accessing objects that got deleted while they became invisible (Cover of Darkness, enemy hero moved etc.) below code allows AI to know deletion of objects out of sight
@@ -386,6 +400,7 @@ void VCAI::objectRemoved(const CGObjectInstance * obj)
 
 	vstd::erase_if_present(visitableObjs, obj);
 	vstd::erase_if_present(alreadyVisited, obj);
+	invalidatePathsAround(obj);
 
 	for(auto h : cb->getHeroesInfo())
 		unreserveObject(h, obj);
@@ -459,6 +474,7 @@ void VCAI::playerBonusChanged(const Bonus & bonus, bool gain)
 {
 	LOG_TRACE_PARAMS(logAi, "gain '%i'", gain);
 	NET_EVENT_HANDLER;
+	ah->invalidateAllPaths();
 }
 
 void VCAI::heroCreated(const CGHeroInstance * h)
@@ -473,6 +489,7 @@ void VCAI::advmapSpellCast(const CGHeroInstance * caster, int spellID)
 {
 	LOG_TRACE_PARAMS(logAi, "spellID '%i", spellID);
 	NET_EVENT_HANDLER;
+	ah->invalidateAllPaths();
 }
 
 void VCAI::showInfoDialog(const std::string & text, const std::vector<Component> & components, int soundID)
@@ -536,6 +553,7 @@ void VCAI::objectPropertyChanged(const SetObjectProperty * sop)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+	ah->invalidateAllPaths();
 	if(sop->what == ObjProperty::OWNER)
 	{
 		if(myCb->getPlayerRelations(playerID, (PlayerColor)sop->val) == PlayerRelations::ENEMIES)
@@ -555,6 +573,7 @@ void VCAI::buildChanged(const CGTownInstance * town, BuildingID buildingID, int
 {
 	LOG_TRACE_PARAMS(logAi, "what '%i'", what);
 	NET_EVENT_HANDLER;
+	ah->invalidateAllPaths();
 
 	if(town->getOwner() == playerID && what == 1) //built
 		completeGoal(sptr(Goals::BuildThis(buildingID, town)));
@@ -602,6 +621,7 @@ void VCAI::yourTurn()
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+	ah->invalidateAllPaths();
 	status.startedTurn();
 	makingTurn = make_unique<boost::thread>(&VCAI::makeTurn, this);
 }
@@ -1634,6 +1654,21 @@ void VCAI::clearPathsInfo()
 	heroesUnableToExplore.clear();
 }
 
+void VCAI::invalidatePathsAround(const CGObjectInstance * obj)
+{
+	//teleport channel may connect this object with any place on the map
+	if(dynamic_cast<const CGTeleport *>(obj))
+	{
+		ah->invalidateAllPaths();
+		return;
+	}
+
+	auto blockedTiles = obj->getBlockedPos();
+	std::vector<int3> tiles(blockedTiles.begin(), blockedTiles.end());
+	tiles.push_back(obj->visitablePos());
+	ah->invalidatePaths(tiles);
+}
+
 void VCAI::validateVisitableObjs()
 {
 	std::string errorMsg;
@@ -237,6 +237,7 @@ public:
 	void markHeroAbleToExplore(HeroPtr h);
 	bool isAbleToExplore(HeroPtr h);
 	void clearPathsInfo();
+	void invalidatePathsAround(const CGObjectInstance * obj);
 
 	void validateObject(const CGObjectInstance * obj); //checks if object is still visible and if not, removes references to it
 	void validateObject(ObjectIdRef obj); //checks if object is still visible and if not, removes references to it
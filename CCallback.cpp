@@ -296,7 +296,7 @@ int3 CCallback::getGuardingCreaturePosition(int3 tile)
 	if (!gs->map->isInTheMap(tile))
 		return int3(-1,-1,-1);
 
-	return gs->map->guardingCreaturePositions[tile.x][tile.y][tile.z];
+	return gs->map->getGuardingCreaturePosition(tile);
 }
 
 void CCallback::calculatePaths( const CGHeroInstance *hero, CPathsInfo &out)
@@ -304,6 +304,11 @@ void CCallback::calculatePaths( const CGHeroInstance *hero, CPathsInfo &out)
 	gs->calculatePaths(hero, out);
 }
 
+void CCallback::calculatePath(const CGHeroInstance * hero, CPathsInfo & out, const int3 & dst)
+{
+	gs->calculatePath(hero, out, dst);
+}
+
 void CCallback::dig( const CGObjectInstance *hero )
 {
 	DigWithHero dwh;
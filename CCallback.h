@@ -109,6 +109,7 @@ public:
 	virtual std::shared_ptr<const CPathsInfo> getPathsInfo(const CGHeroInstance * h);
 
 	virtual void calculatePaths(const CGHeroInstance *hero, CPathsInfo &out);
+	virtual void calculatePath(const CGHeroInstance * hero, CPathsInfo & out, const int3 & dst); //only path to dst is complete, much cheaper for near destinations
 
 	//Set of metrhods that allows adding more interfaces for this player that'll receive game event call-ins.
 	void registerGameInterface(std::shared_ptr<IGameEventsReceiver> gameEvents);
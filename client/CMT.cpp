@@ -1221,6 +1221,7 @@ static bool recreateWindow(int w, int h, int bpp, bool fullscreen, int displayIn
 	}
 
 	screen2 = CSDL_Ext::copySurface(screen);
+	GH.invalidateAll();
 
 
 	if(nullptr == screen2)
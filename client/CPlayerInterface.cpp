@@ -2342,6 +2342,7 @@ void CPlayerInterface::acceptTurn()
 
 	adventureInt->updateNextHero(nullptr);
 	adventureInt->showAll(screen);
+	GH.invalidate(adventureInt->pos);
 
 	if(settings["session"]["autoSkip"].Bool() && !LOCPLINT->shiftPressed())
 	{
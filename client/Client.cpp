@@ -115,6 +115,19 @@ CClient::CClient()
 	IObjectInterface::cb = this;
 	gs = nullptr;
 	erm = nullptr;
+	pathCacheGeneration = 0;
+	lastPathsHero = nullptr;
+	pathRequest = nullptr;
+	calculatingPaths = false;
+}
+
+CClient::~CClient()
+{
+	if(pathThread)
+	{
+		pathThread->interrupt();
+		pathThread->join();
+	}
 }
 
 void CClient::newGame()
@@ -287,6 +300,7 @@ void CClient::endGame()
 		GH.statusbar = nullptr;
 		logNetwork->info("Removed GUI.");
 
+		resetPathCache();
 		vstd::clear_pointer(const_cast<CGameInfo *>(CGI)->mh);
 		vstd::clear_pointer(gs);
 
@@ -316,7 +330,7 @@ void CClient::initMapHandler()
 		logNetwork->trace("Initializing mapHandler (together): %d ms", CSH->th->getDiff());
 	}
 
-	pathCache.clear();
+	resetPathCache();
 }
 
 void CClient::initPlayerInterfaces()
@@ -610,10 +624,66 @@ void CClient::waitForMoveAndSend(PlayerColor color)
 	}
 }
 
+static bool isTileNearPaths(const CPathsInfo & paths, const int3 & tile)
+{
+	for(int dx = -1; dx <= 1; dx++)
+	{
+		for(int dy = -1; dy <= 1; dy++)
+		{
+			const int3 pos(tile.x + dx, tile.y + dy, tile.z);
+
+			if(pos.x < 0 || pos.y < 0 || pos.x >= paths.sizes.x || pos.y >= paths.sizes.y)
+				continue;
+
+			for(int layer = 0; layer < EPathfindingLayer::NUM_LAYERS; layer++)
+			{
+				if(paths.nodes[pos.x][pos.y][pos.z][layer].reachable())
+					return true;
+			}
+		}
+	}
+	return false;
+}
+
 void CClient::invalidatePaths()
 {
 	boost::unique_lock<boost::mutex> pathLock(pathCacheMutex);
+	pathCacheGeneration++;
+
+	for(auto & entry : pathCache)
+		releasePathsInfo(entry.second);
 	pathCache.clear();
+
+	if(lastPathsHero)
+		precalculatePaths(lastPathsHero);
+}
+
+void CClient::invalidatePaths(const CGHeroInstance * h, const std::vector<int3> & changedTiles)
+{
+	boost::unique_lock<boost::mutex> pathLock(pathCacheMutex);
+	pathCacheGeneration++;
+
+	for(auto iter = pathCache.begin(); iter != pathCache.end();)
+	{
+		//hero can't get to changed tile without reaching it or one of its neighbours first
+		const bool affected = iter->first == h || vstd::contains_if(changedTiles, [&](const int3 & tile)
+		{
+			return isTileNearPaths(*iter->second, tile);
+		});
+
+		if(affected)
+		{
+			releasePathsInfo(iter->second);
+			iter = pathCache.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	if(lastPathsHero && !vstd::contains(pathCache, lastPathsHero))
+		precalculatePaths(lastPathsHero);
 }
 
 std::shared_ptr<const CPathsInfo> CClient::getPathsInfo(const CGHeroInstance * h)
@@ -621,11 +691,17 @@ std::shared_ptr<const CPathsInfo> CClient::getPathsInfo(const CGHeroInstance * h
 	assert(h);
 	boost::unique_lock<boost::mutex> pathLock(pathCacheMutex);
 
+	//only heroes shown on adventure map are worth speculative recalculation
+	//not waiting for background calculation here: caller may hold game state lock needed by it
+	auto owner = playerint.find(h->tempOwner);
+	if(owner != playerint.end() && owner->second->human)
+		lastPathsHero = h;
+
 	auto iter = pathCache.find(h);
 
 	if(iter == std::end(pathCache))
 	{
-		std::shared_ptr<CPathsInfo> paths = std::make_shared<CPathsInfo>(getMapSize(), h);
+		std::shared_ptr<CPathsInfo> paths = acquirePathsInfo(h);
 
 		gs->calculatePaths(h, *paths.get());
 
@@ -638,6 +714,115 @@ std::shared_ptr<const CPathsInfo> CClient::getPathsInfo(const CGHeroInstance * h
 	}
 }
 
+std::shared_ptr<CPathsInfo> CClient::acquirePathsInfo(const CGHeroInstance * h)
+{
+	if(pathPool.empty())
+		return std::make_shared<CPathsInfo>(getMapSize(), h);
+
+	std::shared_ptr<CPathsInfo> paths = pathPool.back();
+	pathPool.pop_back();
+	paths->reset();
+	return paths;
+}
+
+void CClient::releasePathsInfo(std::shared_ptr<CPathsInfo> & paths)
+{
+	if(paths.use_count() == 1 && pathPool.size() < MAX_POOLED_PATHS)
+		pathPool.push_back(std::move(paths));
+}
+
+static bool isHeroOnMap(const CGameState * gs, const CGHeroInstance * h)
+{
+	return vstd::contains_if(gs->map->heroesOnMap, [h](const CGHeroInstance * hero){ return hero == h; });
+}
+
+void CClient::precalculatePaths(const CGHeroInstance * h)
+{
+	if(!isHeroOnMap(gs, h))
+		return;
+
+	pathRequest = h;
+
+	if(pathThread)
+		pathThreadCondition.notify_all();
+	else
+		pathThread = std::make_shared<boost::thread>(std::bind(&CClient::precalculatePathsLoop, this));
+}
+
+void CClient::precalculatePathsLoop()
+{
+	setThreadName("CClient::precalculatePathsLoop");
+
+	try
+	{
+		boost::unique_lock<boost::mutex> pathLock(pathCacheMutex);
+		while(true)
+		{
+			while(!pathRequest)
+				pathThreadCondition.wait(pathLock);
+
+			const CGHeroInstance * h = pathRequest;
+			pathRequest = nullptr;
+
+			if(vstd::contains(pathCache, h))
+				continue;
+
+			const ui64 generation = pathCacheGeneration;
+			std::shared_ptr<CPathsInfo> paths = acquirePathsInfo(h);
+			calculatingPaths = true;
+			pathLock.unlock();
+
+			bool calculated = false;
+			{
+				//thread which invalidates paths may hold interface lock and wait for this calculation or wait for game state lock as writer
+				//so waiting for game state is abandoned once results would be dropped anyway
+				boost::shared_lock<boost::shared_mutex> gsLock(CGameState::mutex, boost::defer_lock);
+				while(!gsLock.try_lock_for(boost::chrono::milliseconds(10)))
+				{
+					boost::unique_lock<boost::mutex> checkLock(pathCacheMutex);
+					if(generation != pathCacheGeneration)
+						break;
+				}
+
+				//hero may be removed by packs applied after paths were requested
+				if(gsLock.owns_lock() && isHeroOnMap(gs, h))
+				{
+					gs->calculatePaths(h, *paths.get());
+					calculated = true;
+				}
+			}
+
+			pathLock.lock();
+			calculatingPaths = false;
+
+			//interface could have requested and calculated same paths in the meantime
+			if(calculated && generation == pathCacheGeneration && !vstd::contains(pathCache, h))
+				pathCache[h] = paths;
+			else
+				releasePathsInfo(paths);
+
+			pathThreadCondition.notify_all();
+		}
+	}
+	catch(boost::thread_interrupted &)
+	{
+	}
+}
+
+void CClient::resetPathCache()
+{
+	boost::unique_lock<boost::mutex> pathLock(pathCacheMutex);
+	lastPathsHero = nullptr;
+	pathRequest = nullptr;
+	pathCacheGeneration++; //background calculation does not wait for game state anymore
+
+	while(calculatingPaths)
+		pathThreadCondition.wait(pathLock);
+
+	pathCache.clear();
+	pathPool.clear();
+}
+
 PlayerColor CClient::getLocalPlayer() const
 {
 	if(LOCPLINT)
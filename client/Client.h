@@ -100,8 +100,25 @@ class CClient : public IGameCallback
 {
 	std::shared_ptr<CApplier<CBaseForCLApply>> applier;
 
+	static const size_t MAX_POOLED_PATHS = 4;
+
 	mutable boost::mutex pathCacheMutex;
 	std::map<const CGHeroInstance *, std::shared_ptr<CPathsInfo>> pathCache;
+	std::vector<std::shared_ptr<CPathsInfo>> pathPool; //storages of invalidated paths, reused to avoid reallocation of nodes
+	ui64 pathCacheGeneration; //incremented on every invalidation, background results of older generation are dropped
+	const CGHeroInstance * lastPathsHero; //hero which paths were requested last, usually selected one
+
+	/// paths of selected hero are recalculated on own thread, not in thread pool, since calculation has to lock game state
+	std::shared_ptr<boost::thread> pathThread;
+	boost::condition_variable pathThreadCondition; //signalled when paths are requested or background calculation is finished
+	const CGHeroInstance * pathRequest; //hero which paths should be calculated in background, nullptr if none
+	bool calculatingPaths; //true while background thread works on taken request
+
+	std::shared_ptr<CPathsInfo> acquirePathsInfo(const CGHeroInstance * h); //requires pathCacheMutex
+	void releasePathsInfo(std::shared_ptr<CPathsInfo> & paths); //requires pathCacheMutex, returns storage to pool if nobody else uses it
+	void precalculatePaths(const CGHeroInstance * h); //requires pathCacheMutex
+	void precalculatePathsLoop();
+	void resetPathCache();
 
 	std::map<PlayerColor, std::shared_ptr<boost::thread>> playerActionThreads;
 	void waitForMoveAndSend(PlayerColor color);
@@ -121,6 +138,7 @@ public:
 
 	CScriptingModule * erm;
 	CClient();
+	~CClient();
 
 	void newGame();
 	void loadGame();
@@ -152,6 +170,8 @@ public:
 	void stopAllBattleActions();
 
 	void invalidatePaths();
+	/// drops paths of given hero and of all heroes which could reach any of changed tiles or their neighbours
+	void invalidatePaths(const CGHeroInstance * h, const std::vector<int3> & changedTiles = std::vector<int3>());
 	std::shared_ptr<const CPathsInfo> getPathsInfo(const CGHeroInstance * h);
 	virtual PlayerColor getLocalPlayer() const override;
 
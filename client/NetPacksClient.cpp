@@ -172,7 +172,7 @@ void SetMana::applyCl(CClient *cl)
 void SetMovePoints::applyCl(CClient *cl)
 {
 	const CGHeroInstance *h = cl->getHero(hid);
-	cl->invalidatePaths();
+	cl->invalidatePaths(h);
 	callInterfaceIfPresent(cl, h->tempOwner, &IGameEventsReceiver::heroMovePointsChanged, h);
 }
 
@@ -408,7 +408,12 @@ void TryMoveHero::applyFirstCl(CClient *cl)
 void TryMoveHero::applyCl(CClient *cl)
 {
 	const CGHeroInstance *h = cl->getHero(id);
-	cl->invalidatePaths();
+
+	//only paths passing near old and new hero position or revealed tiles may change
+	std::vector<int3> changedTiles(fowRevealed.begin(), fowRevealed.end());
+	changedTiles.push_back(CGHeroInstance::convertPosition(start, false));
+	changedTiles.push_back(CGHeroInstance::convertPosition(end, false));
+	cl->invalidatePaths(h, changedTiles);
 
 	if(CGI->mh)
 	{
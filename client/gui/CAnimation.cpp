@@ -19,6 +19,7 @@
 
 #include "../lib/filesystem/Filesystem.h"
 #include "../lib/filesystem/ISimpleResourceLoader.h"
+#include "../lib/CConfigHandler.h"
 #include "../lib/JsonNode.h"
 #include "../lib/CRandomGenerator.h"
 
@@ -48,7 +49,7 @@ private:
 	//offset[group][frame] - offset of frame data in file
 	std::map<size_t, std::vector <size_t> > offset;
 
-	std::unique_ptr<ui8[]>       data;
+	std::shared_ptr<const ui8>   data; // shared with animation file cache, never modified
 	std::unique_ptr<SDL_Color[]> palette;
 
 public:
@@ -96,6 +97,7 @@ public:
 	void draw(SDL_Surface * where, int posX=0, int posY=0, Rect *src=nullptr, ui8 alpha=255) const override;
 	void draw(SDL_Surface * where, SDL_Rect * dest, SDL_Rect * src, ui8 alpha=255) const override;
 	std::shared_ptr<IImage> scaleFast(float scale) const override;
+	std::shared_ptr<IImage> convertTo(SDL_Surface * target) const override;
 	void exportBitmap(const boost::filesystem::path & path) const override;
 	void playerColored(PlayerColor player) override;
 	void setFlagColor(PlayerColor player) override;
@@ -135,47 +137,87 @@ public:
 	~SDLImageLoader();
 };
 
-// Extremely simple file cache. TODO: smarter, more general solution
+/// Cache of raw animation files, shared between all CDefFile instances
+/// Files are immutable once loaded and handed out by reference, so cache hits do not copy any data
+/// Least recently used files are evicted once total size exceeds capacity
 class CFileCache
 {
-	static const int cacheSize = 50; //Max number of cached files
 	struct FileData
 	{
-		ResourceID             name;
-		size_t                 size;
-		std::unique_ptr<ui8[]> data;
+		ResourceID                 name;
+		size_t                     size;
+		std::shared_ptr<const ui8> data;
+	};
+
+	typedef std::list<FileData> TFileList;
+
+	TFileList files; // most recently used file is in front
+	std::unordered_map<ResourceID, TFileList::iterator> index;
+
+	size_t capacity; // in bytes
+	size_t usedBytes;
+
+	// updated under lock, but may be read without it
+	std::atomic<ui64> hits;
+	std::atomic<ui64> misses;
 
-		std::unique_ptr<ui8[]> getCopy()
+	boost::mutex mx;
+
+	void evict()
+	{
+		// most recent file always stays in cache, even if it alone exceeds capacity
+		while(usedBytes > capacity && files.size() > 1)
 		{
-			auto ret = std::unique_ptr<ui8[]>(new ui8[size]);
-			std::copy(data.get(), data.get() + size, ret.get());
-			return ret;
+			usedBytes -= files.back().size;
+			index.erase(files.back().name);
+			files.pop_back();
 		}
-		FileData(ResourceID name_, size_t size_, std::unique_ptr<ui8[]> data_):
-			name{std::move(name_)},
-			size{size_},
-			data{std::move(data_)}
-		{}
-	};
+	}
 
-	std::deque<FileData> cache;
 public:
-	std::unique_ptr<ui8[]> getCachedFile(ResourceID rid)
+	CFileCache(size_t capacity_):
+		capacity(capacity_),
+		usedBytes(0),
+		hits(0),
+		misses(0)
+	{}
+
+	std::shared_ptr<const ui8> getCachedFile(const ResourceID & rid)
 	{
-		for(auto & file : cache)
+		boost::unique_lock<boost::mutex> lock(mx);
+
+		auto iter = index.find(rid);
+		if(iter != index.end())
 		{
-			if (file.name == rid)
-				return file.getCopy();
+			hits++;
+			files.splice(files.begin(), files, iter->second);
+			return iter->second->data;
 		}
+
 		// Still here? Cache miss
-		if (cache.size() > cacheSize)
-			cache.pop_front();
+		misses++;
+
+		auto file = CResourceHandler::get()->load(rid)->readAll();
+		std::shared_ptr<const ui8> data(file.first.release(), std::default_delete<ui8[]>());
+
+		files.push_front(FileData{rid, static_cast<size_t>(file.second), data});
+		index[rid] = files.begin();
+		usedBytes += file.second;
+		evict();
 
-		auto data =  CResourceHandler::get()->load(rid)->readAll();
+		logAnim->trace("Animation cache miss: %s. Hits: %d, misses: %d, cached: %d files, %d bytes", rid.getName(), hits.load(), misses.load(), files.size(), usedBytes);
+		return data;
+	}
 
-		cache.emplace_back(std::move(rid), data.second, std::move(data.first));
+	/// number of requests served from cache and loaded from filesystem, for tuning of cache capacity
+	ui64 getHits() const
+	{
+		return hits;
+	}
 
-		return cache.back().getCopy();
+	ui64 getMisses() const
+	{
+		return misses;
 	}
 };
 
@@ -193,7 +235,12 @@ enum class DefType : uint32_t
 	BATTLE_HERO = 0x49
 };
 
-static CFileCache animationCache;
+static CFileCache & getAnimationCache()
+{
+	// created on first use since cache capacity depends on loaded settings
+	static CFileCache animationCache(settings["video"]["animationCacheSize"].Integer() * 1024 * 1024);
+	return animationCache;
+}
 
 /*************************************************************************
  *  DefFile, class used for def loading                                  *
@@ -235,7 +282,7 @@ CDefFile::CDefFile(std::string Name):
 		{   0,   0,   0, 128},//  50% - shadow body   below selection
 		{   0,   0,   0,  64} // 75% - shadow border below selection
 	};
-	data = animationCache.getCachedFile(ResourceID(std::string("SPRITES/") + Name, EResType::ANIMATION));
+	data = getAnimationCache().getCachedFile(ResourceID(std::string("SPRITES/") + Name, EResType::ANIMATION));
 
 	palette = std::unique_ptr<SDL_Color[]>(new SDL_Color[256]);
 	int it = 0;
@@ -250,9 +297,9 @@ CDefFile::CDefFile(std::string Name):
 
 	for (ui32 i= 0; i<256; i++)
 	{
-		palette[i].r = data[it++];
-		palette[i].g = data[it++];
-		palette[i].b = data[it++];
+		palette[i].r = data.get()[it++];
+		palette[i].g = data.get()[it++];
+		palette[i].b = data.get()[it++];
 		palette[i].a = SDL_ALPHA_OPAQUE;
 	}
 
@@ -715,6 +762,37 @@ std::shared_ptr<IImage> SDLImage::scaleFast(float scale) const
 	return std::shared_ptr<IImage>(ret);
 }
 
+std::shared_ptr<IImage> SDLImage::convertTo(SDL_Surface * target) const
+{
+	if(!surf || surf->format->BitsPerPixel != 8)
+		return nullptr;
+
+	//semi-transparent pixels have to be blended with whatever is below them during drawing
+	const SDL_Color * colors = surf->format->palette->colors;
+	for(int y = 0; y < surf->h; y++)
+	{
+		const ui8 * row = static_cast<const ui8 *>(surf->pixels) + y * surf->pitch;
+		for(int x = 0; x < surf->w; x++)
+		{
+			if(colors[row[x]].a != SDL_ALPHA_OPAQUE)
+				return nullptr;
+		}
+	}
+
+	//same blitter as in draw(), so converted image has exactly same pixels as would be drawn on target
+	SDL_Surface * converted = CSDL_Ext::newSurface(surf->w, surf->h, target);
+	Rect destRect(0, 0, surf->w, surf->h);
+	CSDL_Ext::blit8bppAlphaTo24bpp(surf, nullptr, converted, &destRect);
+	SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE);
+
+	SDLImage * ret = new SDLImage(converted, false);
+
+	ret->fullSize = fullSize;
+	ret->margins = margins;
+
+	return std::shared_ptr<IImage>(ret);
+}
+
 void SDLImage::exportBitmap(const boost::filesystem::path& path) const
 {
 	SDL_SaveBMP(surf, path.string().c_str());
@@ -32,6 +32,10 @@ public:
 
 	virtual std::shared_ptr<IImage> scaleFast(float scale) const = 0;
 
+	//returns copy of image stored in pixel format of "target", which can be drawn on it without palette lookups
+	//returns nullptr if such copy would not look the same, e.g. if image has transparent or shadow pixels
+	virtual std::shared_ptr<IImage> convertTo(SDL_Surface * target) const = 0;
+
 	virtual void exportBitmap(const boost::filesystem::path & path) const = 0;
 
 	//Change palette to specific player
@@ -168,6 +168,7 @@ void CGuiHandler::totalRedraw()
 	for(auto & elem : objsToBlit)
 		elem->showAll(screen2);
 	blitAt(screen2,0,0,screen);
+	invalidateAll();
 }
 
 void CGuiHandler::updateTime()
@@ -402,7 +403,67 @@ void CGuiHandler::simpleRedraw()
 	if(objsToBlit.size() > 1)
 		blitAt(screen2,0,0,screen); //blit background
 	if(!objsToBlit.empty())
+	{
 		objsToBlit.back()->show(screen); //blit active interface/window
+		//background is identical to buffer outside of active interface so only its area has changed
+		invalidate(objsToBlit.back().get());
+	}
+}
+
+void CGuiHandler::invalidate(const Rect & area)
+{
+	Rect changed = area & Rect(0, 0, screen->w, screen->h);
+	if(changed.w <= 0 || changed.h <= 0)
+		return;
+
+	//merge with overlapping areas so no part of screen is uploaded twice
+	for(bool merged = true; merged; )
+	{
+		merged = false;
+		for(auto iter = dirtyRects.begin(); iter != dirtyRects.end(); ++iter)
+		{
+			Rect common = changed & *iter;
+			if(common.w > 0 && common.h > 0)
+			{
+				changed = changed | *iter;
+				dirtyRects.erase(iter);
+				merged = true;
+				break;
+			}
+		}
+	}
+	dirtyRects.push_back(changed);
+
+	//too many small uploads are slower than single large one
+	if(dirtyRects.size() > MAX_DIRTY_RECTS)
+		invalidateAll();
+}
+
+void CGuiHandler::invalidate(const IShowActivatable * object)
+{
+	if(auto intObject = dynamic_cast<const CIntObject *>(object))
+		invalidate(intObject->pos);
+	else
+		invalidateAll();
+}
+
+void CGuiHandler::invalidateAll()
+{
+	dirtyRects.assign(1, Rect(0, 0, screen->w, screen->h));
+}
+
+void CGuiHandler::uploadDirtyRects()
+{
+	const int bpp = screen->format->BytesPerPixel;
+
+	uploadedBytes = 0;
+	for(auto & rect : dirtyRects)
+	{
+		auto pixels = static_cast<const ui8 *>(screen->pixels) + rect.y * screen->pitch + rect.x * bpp;
+		SDL_UpdateTexture(screenTexture, &rect, pixels, screen->pitch);
+		uploadedBytes += rect.w * rect.h * bpp;
+	}
+	dirtyRects.clear();
 }
 
 void CGuiHandler::handleMoveInterested(const SDL_MouseMotionEvent & motion)
@@ -456,7 +517,7 @@ void CGuiHandler::renderFrame()
 		if(settings["general"]["showfps"].Bool())
 			drawFPSCounter();
 
-		SDL_UpdateTexture(screenTexture, nullptr, screen->pixels, screen->pitch);
+		uploadDirtyRects();
 
 		SDL_RenderCopy(mainRenderer, screenTexture, nullptr, nullptr);
 
@@ -472,7 +533,7 @@ void CGuiHandler::renderFrame()
 
 
 CGuiHandler::CGuiHandler()
-	: lastClick(-500, -500),lastClickTime(0), defActionsDef(0), captureChildren(false)
+	: uploadedBytes(0), lastClick(-500, -500),lastClickTime(0), defActionsDef(0), captureChildren(false)
 {
 	continueEventHandling = true;
 	curInt = nullptr;
@@ -500,11 +561,14 @@ void CGuiHandler::breakEventHandling()
 void CGuiHandler::drawFPSCounter()
 {
 	const static SDL_Color yellow = {255, 255, 0, 0};
-	static SDL_Rect overlay = { 0, 0, 64, 32};
+	static SDL_Rect overlay = { 0, 0, 64, 48};
 	Uint32 black = SDL_MapRGB(screen->format, 10, 10, 10);
 	SDL_FillRect(screen, &overlay, black);
 	std::string fps = boost::lexical_cast<std::string>(mainFPSmng->fps);
 	graphics->fonts[FONT_BIG]->renderTextLeft(screen, fps, yellow, Point(10, 10));
+	std::string upload = boost::lexical_cast<std::string>(uploadedBytes / 1024) + " KB";
+	graphics->fonts[FONT_SMALL]->renderTextLeft(screen, upload, yellow, Point(10, 32));
+	invalidate(overlay);
 }
 
 SDL_Keycode CGuiHandler::arrowToNum(SDL_Keycode key)
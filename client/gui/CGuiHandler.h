@@ -64,6 +64,12 @@ public:
 private:
 	std::vector<std::shared_ptr<IShowActivatable>> disposed;
 
+	static const size_t MAX_DIRTY_RECTS = 16;
+	std::vector<Rect> dirtyRects; //parts of screen that were changed since last upload to screen texture, never overlapping
+	size_t uploadedBytes; //amount of screen data uploaded to screen texture during last frame
+
+	void uploadDirtyRects(); //uploads changed parts of screen to screen texture
+
 	std::atomic<bool> continueEventHandling;
 	typedef std::list<CIntObject*> CIntObjectList;
 
@@ -108,6 +114,10 @@ public:
 	void totalRedraw(); //forces total redraw (using showAll), sets a flag, method gets called at the end of the rendering
 	void simpleRedraw(); //update only top interface and draw background from buffer, sets a flag, method gets called at the end of the rendering
 
+	void invalidate(const Rect & area); //marks part of screen as changed, it will be uploaded to screen texture in next frame
+	void invalidate(const IShowActivatable * object); //marks area occupied by object as changed
+	void invalidateAll(); //marks whole screen as changed
+
 	void pushInt(std::shared_ptr<IShowActivatable> newInt); //deactivate old top interface, activates this one and pushes to the top
 	template <typename T, typename ... Args>
 	void pushIntT(Args && ... args)
@@ -129,7 +139,7 @@ public:
 	void handleMoveInterested( const SDL_MouseMotionEvent & motion );
 	void fakeMouseMove();
 	void breakEventHandling(); //current event won't be propagated anymore
-	void drawFPSCounter(); // draws the FPS to the upper left corner of the screen
+	void drawFPSCounter(); // draws the FPS and size of screen texture upload to the upper left corner of the screen
 
 	static SDL_Keycode arrowToNum(SDL_Keycode key); //converts arrow key to according numpad key
 	static SDL_Keycode numToDigit(SDL_Keycode key);//converts numpad digit key to normal digit key
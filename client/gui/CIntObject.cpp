@@ -307,6 +307,7 @@ void CIntObject::redraw()
 			showAll(screenBuf);
 			if(screenBuf != screen)
 				showAll(screen);
+			GH.invalidate(pos);
 		}
 	}
 }
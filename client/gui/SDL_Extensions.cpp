@@ -303,6 +303,13 @@ int CSDL_Ext::blit8bppAlphaTo24bppT(const SDL_Surface * src, const SDL_Rect * sr
 			Uint8 *colory = (Uint8*)src->pixels + srcy*src->pitch + srcx;
 			Uint8 *py = (Uint8*)dst->pixels + dstRect->y*dst->pitch + dstRect->x*bpp;
 
+			if(bpp == 4)
+			{
+				blit8bppAlphaTo32bppRows(src->format->palette, colory, src->pitch, py, dst->pitch, w, h);
+				SDL_UnlockSurface(dst);
+				return 0;
+			}
+
 			for(int y=h; y; y--, colory+=src->pitch, py+=dst->pitch)
 			{
 				Uint8 *color = colory;
@@ -311,7 +311,10 @@ void CMainMenu::update()
 	// check for null othervice crash on finishing a campaign
 	// /FIXME: find out why GH.listInt is empty to begin with
 	if(GH.topInt())
+	{
 		GH.topInt()->show(screen);
+		GH.invalidate(GH.topInt().get());
+	}
 }
 
 void CMainMenu::openLobby(ESelectionScreen screenType, bool host, const std::vector<std::string> * names, ELoadMode loadMode)
@@ -48,20 +48,20 @@ struct NeighborTilesInfo
 		 d1,
 		 d2,
 		 d3;
-	NeighborTilesInfo(const int3 & pos, const int3 & sizes, const std::vector< std::vector< std::vector<ui8> > > & visibilityMap)
+	NeighborTilesInfo(const int3 & pos, const int3 & sizes, const FogOfWarMap & visibilityMap)
 	{
 		auto getTile = [&](int dx, int dy)->bool
 		{
 			if ( dx + pos.x < 0 || dx + pos.x >= sizes.x
 			  || dy + pos.y < 0 || dy + pos.y >= sizes.y)
 				return false;
-			return settings["session"]["spectate"].Bool() ? true : visibilityMap[dx+pos.x][dy+pos.y][pos.z];
+			return settings["session"]["spectate"].Bool() ? true : visibilityMap.isVisible(int3(dx+pos.x, dy+pos.y, pos.z));
 		};
 		d7 = getTile(-1, -1); //789
 		d8 = getTile( 0, -1); //456
 		d9 = getTile(+1, -1); //123
 		d4 = getTile(-1, 0);
-		d5 = visibilityMap[pos.x][pos.y][pos.z];
+		d5 = visibilityMap.isVisible(pos);
 		d6 = getTile(+1, 0);
 		d1 = getTile(-1, +1);
 		d2 = getTile( 0, +1);
@@ -216,6 +216,23 @@ void CMapHandler::initTerrainGraphics()
 	loadFlipped(3, roadAnimations, roadImages, ROAD_FILES);
 	loadFlipped(4, riverAnimations, riverImages, RIVER_FILES);
 
+	//terrain covers whole visible map, keep opaque tiles in screen format so they are drawn by plain copy
+	//lava and water have animated palettes (see updateWater) so they must remain indexed
+	for(int i = 0; i < GameConstants::TERRAIN_TYPES; i++)
+	{
+		if(i == ETerrainType::LAVA || i == ETerrainType::WATER)
+			continue;
+
+		for(auto & views : terrainImages[i])
+		{
+			for(auto & image : views)
+			{
+				if(auto converted = image->convertTo(screen))
+					image = converted;
+			}
+		}
+	}
+
 	// Create enough room for the whole map and its frame
 
 	ttiles.resize(sizes.x, frameW, frameW);
@@ -564,7 +581,7 @@ void CMapHandler::CMapWorldViewBlitter::drawTileOverlay(SDL_Surface * targetSurf
 		const CGObjectInstance * obj = object.obj;
 
 		const bool sameLevel = obj->pos.z == pos.z;
-		const bool isVisible = settings["session"]["spectate"].Bool() ? true : (*info->visibilityMap)[pos.x][pos.y][pos.z];
+		const bool isVisible = settings["session"]["spectate"].Bool() ? true : info->visibilityMap->isVisible(pos);
 		const bool isVisitable = obj->visitableAt(pos.x, pos.y);
 
 		if(sameLevel && isVisible && isVisitable)
@@ -902,7 +919,7 @@ void CMapHandler::CMapBlitter::blit(SDL_Surface * targetSurf, const MapDrawingIn
 			{
 				const TerrainTile2 & tile = parent->ttiles[pos.x][pos.y][pos.z];
 
-				if(!settings["session"]["spectate"].Bool() && !(*info->visibilityMap)[pos.x][pos.y][topTile.z] && !info->showAllTerrain)
+				if(!settings["session"]["spectate"].Bool() && !info->visibilityMap->isVisible(int3(pos.x, pos.y, topTile.z)) && !info->showAllTerrain)
 					drawFow(targetSurf);
 
 				// overlay needs to be drawn over fow, because of artifacts-aura-like spells
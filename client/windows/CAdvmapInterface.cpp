@@ -1868,6 +1868,7 @@ void CAdvMapInt::aiTurnStarted()
 	adventureInt->minimap.setAIRadar(true);
 	adventureInt->infoBar.startEnemyTurn(LOCPLINT->cb->getCurrentPlayer());
 	adventureInt->infoBar.showAll(screen);//force refresh on inactive object
+	GH.invalidate(adventureInt->infoBar.pos);
 }
 
 void CAdvMapInt::adjustActiveness(bool aiTurnStart)
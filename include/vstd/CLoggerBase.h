@@ -62,9 +62,16 @@ public:
 	virtual bool isDebugEnabled() const = 0;
 	virtual bool isTraceEnabled() const = 0;
 
+	/// Returns the log level applied on this logger whether directly or indirectly.
+	virtual ELogLevel::ELogLevel getEffectiveLevel() const = 0;
+
 	template<typename T, typename ... Args>
 	void log(ELogLevel::ELogLevel level, const std::string & format, T t, Args ... args) const
 	{
+		// do not format messages that won't be logged anyway
+		if(getEffectiveLevel() > level)
+			return;
+
 		try
 		{
 			boost::format fmt(format);
@@ -274,7 +274,10 @@ void CCreatureSet::setStackCount(SlotID slot, TQuantity count)
 	assert(hasStackAtSlot(slot));
 	assert(stacks[slot]->count + count > 0);
 	if (VLC->modh->modules.STACK_EXP && count > stacks[slot]->count)
+	{
 		stacks[slot]->experience *= (count / static_cast<double>(stacks[slot]->count));
+		stacks[slot]->nodeHasChanged(); //experience rank may have changed
+	}
 	stacks[slot]->count = count;
 	armyChanged();
 }
@@ -288,6 +291,7 @@ void CCreatureSet::setStackExp(SlotID slot, TExpType exp)
 {
 	assert(hasStackAtSlot(slot));
 	stacks[slot]->experience = exp;
+	stacks[slot]->nodeHasChanged();
 }
 
 void CCreatureSet::clear()
@@ -617,6 +621,7 @@ void CStackInstance::giveStackExp(TExpType exp)
 	vstd::amin(exp, (TExpType)maxExp); //prevent exp overflow due to different types
 	vstd::amin(exp, (maxExp * creh->maxExpPerBattle[level])/100);
 	vstd::amin(experience += exp, maxExp); //can't get more exp than this limit
+	nodeHasChanged();
 }
 
 void CStackInstance::setType(CreatureID creID)
@@ -829,7 +834,10 @@ void CCommanderInstance::setAlive (bool Alive)
 void CCommanderInstance::giveStackExp (TExpType exp)
 {
 	if (alive)
+	{
 		experience += exp;
+		nodeHasChanged();
+	}
 }
 
 int CCommanderInstance::getExpRank() const
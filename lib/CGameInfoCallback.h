@@ -19,6 +19,7 @@ struct PlayerSettings;
 struct CPackForClient;
 struct TerrainTile;
 struct PlayerState;
+class FogOfWarMap;
 class CTown;
 struct StartInfo;
 struct InfoAboutTown;
@@ -146,7 +147,7 @@ public:
 
 	virtual int getResourceAmount(Res::ERes type) const;
 	virtual TResources getResourceAmount() const;
-	virtual const std::vector< std::vector< std::vector<ui8> > > & getVisibilityMap()const; //returns visibility map
+	virtual const FogOfWarMap & getVisibilityMap()const; //returns visibility map
 	//virtual const PlayerSettings * getPlayerSettings(PlayerColor color) const;
 };
 
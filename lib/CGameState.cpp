@@ -1514,29 +1514,13 @@ void CGameState::initFogOfWar()
 	logGlobal->debug("\tFog of war"); //FIXME: should be initialized after all bonuses are set
 	for(auto & elem : teams)
 	{
-		elem.second.fogOfWarMap.resize(map->width);
-		for(int g=0; g<map->width; ++g)
-			elem.second.fogOfWarMap[g].resize(map->height);
-
-		for(int g=-0; g<map->width; ++g)
-			for(int h=0; h<map->height; ++h)
-				elem.second.fogOfWarMap[g][h].resize(map->twoLevel ? 2 : 1, 0);
-
-		for(int g=0; g<map->width; ++g)
-			for(int h=0; h<map->height; ++h)
-				for(int v = 0; v < (map->twoLevel ? 2 : 1); ++v)
-					elem.second.fogOfWarMap[g][h][v] = 0;
+		elem.second.fogOfWarMap.resize(getMapSize());
 
 		for(CGObjectInstance *obj : map->objects)
 		{
 			if(!obj || !vstd::contains(elem.second.players, obj->tempOwner)) continue; //not a flagged object
 
-			std::unordered_set<int3, ShashInt3> tiles;
-			getTilesInRange(tiles, obj->getSightCenter(), obj->getSightRadius(), obj->tempOwner, 1);
-			for(int3 tile : tiles)
-			{
-				elem.second.fogOfWarMap[tile.x][tile.y][tile.z] = 1;
-			}
+			elem.second.fogOfWarMap.revealArea(obj->getSightCenter(), obj->getSightRadius());
 		}
 	}
 }
@@ -1980,6 +1964,12 @@ void CGameState::calculatePaths(std::shared_ptr<PathfinderConfig> config, const
 	pathfinder.calculatePaths();
 }
 
+void CGameState::calculatePath(const CGHeroInstance * hero, CPathsInfo & out, const int3 & dst)
+{
+	CPathfinder pathfinder(out, this, hero);
+	pathfinder.calculatePath(dst);
+}
+
 /**
  * Tells if the tile is guarded by a monster as well as the position
  * of the monster that will attack on it.
@@ -2037,7 +2027,7 @@ std::vector<CGObjectInstance*> CGameState::guardingCreatures (int3 pos) const
 
 int3 CGameState::guardingCreaturePosition (int3 pos) const
 {
-	return gs->map->guardingCreaturePositions[pos.x][pos.y][pos.z];
+	return gs->map->getGuardingCreaturePosition(pos);
 }
 
 void CGameState::updateRumor()
@@ -2121,7 +2111,7 @@ bool CGameState::isVisible(int3 pos, PlayerColor player)
 	if(player.isSpectator())
 		return true;
 
-	return getPlayerTeam(player)->fogOfWarMap[pos.x][pos.y][pos.z];
+	return getPlayerTeam(player)->fogOfWarMap.isVisible(pos);
 }
 
 bool CGameState::isVisible( const CGObjectInstance *obj, boost::optional<PlayerColor> player )
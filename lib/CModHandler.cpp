@@ -21,6 +21,7 @@
 #include "mapObjects/CObjectHandler.h"
 #include "StringConstants.h"
 #include "CStopWatch.h"
+#include "CThreadHelper.h"
 #include "IHandlerBase.h"
 #include "spells/CSpellHandler.h"
 #include "CSkillHandler.h"
@@ -327,12 +328,8 @@ ContentTypeHandler::ContentTypeHandler(IHandlerBase * handler, std::string objec
 	}
 }
 
-bool ContentTypeHandler::preloadModData(std::string modName, std::vector<std::string> fileList, bool validate)
+void ContentTypeHandler::preloadModData(std::string modName, JsonNode data)
 {
-	bool result;
-	JsonNode data = JsonUtils::assembleFromFiles(fileList, result);
-	data.setMeta(modName);
-
 	ModInfo & modInfo = modData[modName];
 
 	for(auto entry : data.Struct())
@@ -359,33 +356,36 @@ bool ContentTypeHandler::preloadModData(std::string modName, std::vector<std::st
 			JsonUtils::merge(remoteConf, entry.second);
 		}
 	}
-	return result;
 }
 
 bool ContentTypeHandler::loadMod(std::string modName, bool validate)
 {
 	ModInfo & modInfo = modData[modName];
-	bool result = true;
-
-	auto performValidate = [&,this](JsonNode & data, const std::string & name){
-		handler->beforeValidate(data);
-		if (validate)
-			result &= JsonUtils::validate(data, "vcmi:" + objectName, name);
-	};
 
 	// apply patches
 	if (!modInfo.patches.isNull())
 		JsonUtils::merge(modInfo.modData, modInfo.patches);
 
+	struct ObjectEntry
+	{
+		const std::string * name;
+		JsonNode * data;
+		boost::optional<size_t> index;
+	};
+	std::vector<ObjectEntry> objects;
+	objects.reserve(modInfo.modData.Struct().size());
+
 	for(auto & entry : modInfo.modData.Struct())
 	{
 		const std::string & name = entry.first;
 		JsonNode & data = entry.second;
+		boost::optional<size_t> objectIndex;
 
 		if (vstd::contains(data.Struct(), "index") && !data["index"].isNull())
 		{
 			// try to add H3 object data
 			size_t index = data["index"].Float();
+			objectIndex = index;
 
 			if(originalData.size() > index)
 			{
@@ -398,18 +398,34 @@ bool ContentTypeHandler::loadMod(std::string modName, bool validate)
 			{
 				logMod->warn("no original data in loadMod(%s) at index %d", name, index);
 			}
-			performValidate(data, name);
-			handler->loadObject(modName, name, data, index);
 		}
 		else
 		{
-			// normal new object
 			logMod->trace("no index in loadMod(%s)", name);
-			performValidate(data,name);
-			handler->loadObject(modName, name, data);
 		}
+		handler->beforeValidate(data);
+		objects.push_back({&name, &data, objectIndex});
 	}
-	return result;
+
+	// validation only reads data so all objects can be checked in parallel
+	std::vector<ui8> valid(objects.size(), true);
+	if (validate)
+	{
+		CThreadPool::get().parallelFor(0, objects.size(), [&](size_t i)
+		{
+			valid[i] = JsonUtils::validate(*objects[i].data, "vcmi:" + objectName, *objects[i].name);
+		});
+	}
+
+	// objects must be loaded sequentially, in the same order as before, to get the same identifiers
+	for(auto & object : objects)
+	{
+		if (object.index)
+			handler->loadObject(modName, *object.name, *object.data, *object.index);
+		else
+			handler->loadObject(modName, *object.name, *object.data);
+	}
+	return !vstd::contains(valid, false);
 }
 
 
@@ -442,16 +458,6 @@ void CContentHandler::init()
 	//TODO: any other types of moddables?
 }
 
-bool CContentHandler::preloadModData(std::string modName, JsonNode modConfig, bool validate)
-{
-	bool result = true;
-	for(auto & handler : handlers)
-	{
-		result &= handler.second.preloadModData(modName, modConfig[handler.first].convertTo<std::vector<std::string> >(), validate);
-	}
-	return result;
-}
-
 bool CContentHandler::loadMod(std::string modName, bool validate)
 {
 	bool result = true;
@@ -478,20 +484,55 @@ void CContentHandler::afterLoadFinalization()
 	}
 }
 
-void CContentHandler::preloadData(CModInfo & mod)
+void CContentHandler::preloadData(const std::vector<CModInfo *> & mods)
 {
-	bool validate = (mod.validation != CModInfo::PASSED);
+	std::vector<std::string> handlerNames;
+	for(auto & handler : handlers)
+		handlerNames.push_back(handler.first);
 
-	// print message in format [<8-symbols checksum>] <modname>
-	logMod->info("\t\t[%08x]%s", mod.checksum, mod.name);
+	// one job per mod and handler to parse data files plus one job per mod to validate mod.json
+	const size_t jobsPerMod = handlerNames.size() + 1;
+	std::vector<JsonNode> parsedData(mods.size() * jobsPerMod);
+	std::vector<ui8> parsedValid(mods.size() * jobsPerMod, true);
 
-	if (validate && mod.identifier != "core")
+	CThreadPool::get().parallelFor(0, mods.size() * jobsPerMod, [&](size_t i)
 	{
-		if (!JsonUtils::validate(mod.config, "vcmi:mod", mod.identifier))
-			mod.validation = CModInfo::FAILED;
+		const CModInfo & mod = *mods[i / jobsPerMod];
+		const size_t handlerIndex = i % jobsPerMod;
+
+		if (handlerIndex == handlerNames.size())
+		{
+			if (mod.validation != CModInfo::PASSED && mod.identifier != "core")
+				parsedValid[i] = JsonUtils::validate(mod.config, "vcmi:mod", mod.identifier);
+		}
+		else
+		{
+			bool isValid;
+			auto fileList = mod.config[handlerNames[handlerIndex]].convertTo<std::vector<std::string>>();
+			parsedData[i] = JsonUtils::assembleFromFiles(fileList, isValid);
+			parsedData[i].setMeta(mod.identifier);
+			parsedValid[i] = isValid;
+		}
+	});
+
+	// merging of parsed data must follow load order since mods may patch objects of other mods
+	for(size_t modIndex = 0; modIndex < mods.size(); modIndex++)
+	{
+		CModInfo & mod = *mods[modIndex];
+
+		// print message in format [<8-symbols checksum>] <modname>
+		logMod->info("\t\t[%08x]%s", mod.checksum, mod.name);
+
+		for(size_t handlerIndex = 0; handlerIndex < jobsPerMod; handlerIndex++)
+		{
+			const size_t i = modIndex * jobsPerMod + handlerIndex;
+
+			if (!parsedValid[i])
+				mod.validation = CModInfo::FAILED;
+			if (handlerIndex < handlerNames.size())
+				handlers.at(handlerNames[handlerIndex]).preloadModData(mod.identifier, std::move(parsedData[i]));
+		}
 	}
-	if (!preloadModData(mod.identifier, mod.config, validate))
-		mod.validation = CModInfo::FAILED;
 }
 
 void CContentHandler::load(CModInfo & mod)
@@ -928,6 +969,15 @@ void CModHandler::loadModFilesystems()
 		CModInfo & mod = allMods[modName];
 		CResourceHandler::addFilesystem("data", modName, genModFilesystem(modName, mod.config));
 	}
+
+	std::vector<ui32> checksums(activeMods.size());
+	CThreadPool::get().parallelFor(0, activeMods.size(), [&](size_t i)
+	{
+		logMod->trace("Generating checksum for %s", activeMods[i]);
+		checksums[i] = calculateModChecksum(activeMods[i], CResourceHandler::get(activeMods[i]));
+	});
+	for(size_t i = 0; i < activeMods.size(); i++)
+		allMods[activeMods[i]].updateChecksum(checksums[i]);
 }
 
 CModInfo & CModHandler::getModData(TModID modId)
@@ -944,6 +994,21 @@ CModInfo & CModHandler::getModData(TModID modId)
 	}
 }
 
+ui32 CModHandler::getContentChecksum() const
+{
+	boost::crc_32_type checksum;
+	checksum.process_bytes(reinterpret_cast<const void *>(&coreMod.checksum), sizeof(coreMod.checksum));
+
+	// mod order affects loaded data as well
+	for(const TModID & modName : activeMods)
+	{
+		const CModInfo & mod = allMods.at(modName);
+		checksum.process_bytes(reinterpret_cast<const void *>(modName.data()), modName.size());
+		checksum.process_bytes(reinterpret_cast<const void *>(&mod.checksum), sizeof(mod.checksum));
+	}
+	return checksum.checksum();
+}
+
 void CModHandler::initializeConfig()
 {
 	loadConfigFromFile("defaultMods.json");
@@ -957,22 +1022,18 @@ void CModHandler::load()
 
 	content.init();
 
-	for(const TModID & modName : activeMods)
-	{
-		logMod->trace("Generating checksum for %s", modName);
-		allMods[modName].updateChecksum(calculateModChecksum(modName, CResourceHandler::get(modName)));
-	}
-
 	// first - load virtual "core" mod that contains all data
 	// TODO? move all data into real mods? RoE, AB, SoD, WoG
-	content.preloadData(coreMod);
+	std::vector<CModInfo *> loadOrder;
+	loadOrder.push_back(&coreMod);
 	for(const TModID & modName : activeMods)
-		content.preloadData(allMods[modName]);
+		loadOrder.push_back(&allMods[modName]);
+
+	content.preloadData(loadOrder);
 	logMod->info("\tParsing mod data: %d ms", timer.getDiff());
 
-	content.load(coreMod);
-	for(const TModID & modName : activeMods)
-		content.load(allMods[modName]);
+	for(CModInfo * mod : loadOrder)
+		content.load(*mod);
 
 	content.loadCustom();
 
@@ -131,7 +131,7 @@ public:
 
 	/// local version of methods in ContentHandler
 	/// returns true if loading was successful
-	bool preloadModData(std::string modName, std::vector<std::string> fileList, bool validate);
+	void preloadModData(std::string modName, JsonNode data);
 	bool loadMod(std::string modName, bool validate);
 	void loadCustom();
 	void afterLoadFinalization();
@@ -140,9 +140,6 @@ public:
 /// class used to load all game data into handlers. Used only during loading
 class DLL_LINKAGE CContentHandler
 {
-	/// preloads all data from fileList as data from modName.
-	bool preloadModData(std::string modName, JsonNode modConfig, bool validate);
-
 	/// actually loads data in mod
 	bool loadMod(std::string modName, bool validate);
 
@@ -152,8 +149,8 @@ public:
 
 	void init();
 
-	/// preloads all data from fileList as data from modName.
-	void preloadData(CModInfo & mod);
+	/// preloads data of all mods, in load order. Files are read and parsed in parallel
+	void preloadData(const std::vector<CModInfo *> & mods);
 
 	/// actually loads data in mod
 	void load(CModInfo & mod);
@@ -262,6 +259,9 @@ public:
 
 	CModInfo & getModData(TModID modId);
 
+	/// returns checksum of core and all active mods, changes whenever any of loaded data changes
+	ui32 getContentChecksum() const;
+
 	/// returns list of all (active) mods
 	std::vector<std::string> getAllMods();
 	std::vector<std::string> getActiveMods();
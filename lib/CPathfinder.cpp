@@ -290,9 +290,31 @@ CPathfinder::CPathfinder(
 }
 
 void CPathfinder::calculatePaths()
+{
+	search(boost::none);
+}
+
+void CPathfinder::calculatePath(const int3 & dst)
+{
+	if(!isInTheMap(dst))
+	{
+		logGlobal->error("CPathfinder::calculatePath: destination %s is outside of the map", dst.toString());
+		return;
+	}
+
+	if(canEstimateDistance())
+		destinationEstimate = makeDestinationEstimate(dst);
+
+	search(dst);
+}
+
+void CPathfinder::search(const boost::optional<int3> & dst)
 {
 	//logGlobal->info("Calculating paths for hero %s (adress  %d) of player %d", hero->name, hero , hero->tempOwner);
 
+	//CPathsInfo::getNode returns land node for land tiles and sail node for water tiles
+	const ELayer dstLayer = dst && getTile(dst.get(), false)->terType == ETerrainType::WATER ? ELayer::SAIL : ELayer::LAND;
+
 	//initial tile - set cost on 0 and add to the queue
 	CGPathNode * initialNode = config->nodeStorage->getInitialNode();
 
@@ -305,16 +327,36 @@ void CPathfinder::calculatePaths()
 	if(isHeroPatrolLocked())
 		return;
 
-	pq.push(initialNode);
-	while(!pq.empty())
+	pushNode(initialNode);
+	while(!pq.empty() || !estimatedPq.empty())
 	{
-		auto node = pq.top();
+		CGPathNode * node;
+
+		if(destinationEstimate)
+		{
+			node = estimatedPq.top().node;
+			estimatedPq.pop();
+
+			//node was queued again with lower cost and is already processed
+			if(node->locked)
+				continue;
+		}
+		else
+		{
+			node = pq.top();
+			pq.pop();
+		}
+
 		auto excludeOurHero = node->coord == initialNode->coord;
 
 		source.setNode(gs, node, excludeOurHero);
-		pq.pop();
 		source.node->locked = true;
 
+		//nodes are taken in order of cost (plus estimate which never exceeds remaining cost), so nothing processed later can find cheaper path to destination
+		//ties may be resolved in different order than in full search, so path may differ, but never its cost
+		if(dst && node->coord == dst.get() && node->layer == dstLayer)
+			break;
+
 		int movement = source.node->moveRemains;
 		uint8_t turn = source.node->turns;
 		float cost = source.node->cost;
@@ -368,7 +410,7 @@ void CPathfinder::calculatePaths()
 			}
 
 			if(!destination.blocked)
-				pq.push(destination.node);
+				pushNode(destination.node);
 
 		} //neighbours loop
 
@@ -403,12 +445,88 @@ void CPathfinder::calculatePaths()
 				config->nodeStorage->commit(destination, source);
 
 				if(destination.node->action == CGPathNode::TELEPORT_NORMAL)
-					pq.push(destination.node);
+					pushNode(destination.node);
 			}
 		}
 	} //queue loop
 }
 
+void CPathfinder::pushNode(CGPathNode * node)
+{
+	if(destinationEstimate)
+		estimatedPq.push(EstimatedNode{node->cost + destinationEstimate->estimate(node->coord), node});
+	else
+		pq.push(node);
+}
+
+bool CPathfinder::canEstimateDistance() const
+{
+	//embarking and disembarking take all remaining movement points, which may be less than cost of any step
+	if(hero->boat)
+		return false;
+
+	for(auto & obj : gs->map->objects)
+	{
+		if(obj && obj->ID == Obj::BOAT)
+			return false;
+	}
+
+	//step cost is based on movement points of current turn, it can't grow in later turns unless some penalty expires
+	//flying and water walking penalties are expected to only increase step cost
+	auto penalty = [](const Bonus * b) -> bool
+	{
+		if(b->val >= 0)
+			return false;
+
+		if(b->type == Bonus::FLYING_MOVEMENT || b->type == Bonus::WATER_WALKING)
+			return true;
+
+		return (b->type == Bonus::MOVEMENT || b->type == Bonus::LAND_MOVEMENT) && b->duration != Bonus::PERMANENT;
+	};
+
+	return !hero->hasBonus(penalty);
+}
+
+CPathfinder::DestinationEstimate CPathfinder::makeDestinationEstimate(const int3 & dst) const
+{
+	static const int MIN_STEP_COST = 50; //cobblestone road
+
+	DestinationEstimate ret;
+	ret.dst = dst;
+	ret.stepCost = static_cast<float>(MIN_STEP_COST) / hlp->getMaxMovePoints(ELayer::LAND);
+
+	//every teleport and town may be used as entrance or exit, disabled ones only make estimate lower
+	for(auto & obj : gs->map->objects)
+	{
+		if(obj && (dynamic_cast<const CGTeleport *>(obj.get()) || obj->ID == Obj::TOWN))
+			ret.portals.push_back(obj->visitablePos());
+	}
+
+	ret.portalsToDestination = DestinationEstimate::FAR_AWAY;
+	for(auto & portal : ret.portals)
+		vstd::amin(ret.portalsToDestination, DestinationEstimate::steps(portal, dst));
+
+	return ret;
+}
+
+int CPathfinder::DestinationEstimate::steps(const int3 & from, const int3 & to)
+{
+	if(from.z != to.z)
+		return FAR_AWAY; //only teleports lead to another level
+
+	return std::max(std::abs(from.x - to.x), std::abs(from.y - to.y));
+}
+
+float CPathfinder::DestinationEstimate::estimate(const int3 & tile) const
+{
+	int distance = steps(tile, dst);
+
+	for(auto & portal : portals)
+		vstd::amin(distance, steps(tile, portal) + portalsToDestination);
+
+	return distance * stepCost;
+}
+
 std::vector<int3> CPathfinderHelper::getAllowedTeleportChannelExits(TeleportChannelID channelID) const
 {
 	std::vector<int3> allowedExits;
@@ -1012,7 +1130,7 @@ TurnInfo::BonusCache::BonusCache(TBonusListPtr bl)
 TurnInfo::TurnInfo(const CGHeroInstance * Hero, const int turn)
 	: hero(Hero), maxMovePointsLand(-1), maxMovePointsWater(-1)
 {
-	bonuses = hero->getAllBonuses(Selector::days(turn), Selector::all, nullptr, "");
+	bonuses = hero->getAllBonuses(Selector::days(turn), Selector::all, nullptr);
 	bonusCache = make_unique<BonusCache>(bonuses);
 	nativeTerrain = hero->getNativeTerrain();
 }
@@ -1292,6 +1410,15 @@ CPathsInfo::CPathsInfo(const int3 & Sizes, const CGHeroInstance * hero_)
 
 CPathsInfo::~CPathsInfo() = default;
 
+void CPathsInfo::reset()
+{
+	CGPathNode * node = nodes.data();
+	CGPathNode * end = node + nodes.num_elements();
+
+	for(; node != end; ++node)
+		node->reset();
+}
+
 const CGPathNode * CPathsInfo::getPathInfo(const int3 & tile) const
 {
 	assert(vstd::iswithin(tile.x, 0, sizes.x));
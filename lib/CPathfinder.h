@@ -54,11 +54,12 @@ struct DLL_LINKAGE CGPathNode
 		BLOCKED //tile can't be entered nor visited
 	};
 
+	// fields are ordered so that one-byte ones share the tail of the structure
 	CGPathNode * theNodeBefore;
 	int3 coord; //coordinates
-	ELayer layer;
 	ui32 moveRemains; //remaining movement points after hero reaches the tile
 	float cost; //total cost of the path to this tile measured in turns with fractions
+	ELayer layer;
 	ui8 turns; //how many turns we have to wait before reaching the tile - 0 means current turn
 
 	EAccessibility accessible;
@@ -127,6 +128,8 @@ struct DLL_LINKAGE CPathsInfo
 
 	CPathsInfo(const int3 & Sizes, const CGHeroInstance * hero_);
 	~CPathsInfo();
+	/// clears results of previous pathfinding, so nodes can be reused without reallocation
+	void reset();
 	const CGPathNode * getPathInfo(const int3 & tile) const;
 	bool getPath(CGPath & out, const int3 & dst) const;
 	const CGPathNode * getNode(const int3 & coord) const;
@@ -401,6 +404,11 @@ public:
 
 	void calculatePaths(); //calculates possible paths for hero, uses current hero position and movement left; returns pointer to newly allocated CPath or nullptr if path does not exists
 
+	/// calculates paths only until best path to given tile is known, other nodes may be left incomplete
+	/// cost of destination node and of every node on its path is same as after calculatePaths,
+	/// but if several paths are equally cheap, a different one of them may be chosen
+	void calculatePath(const int3 & dst);
+
 private:
 	typedef EPathfindingLayer ELayer;
 
@@ -425,6 +433,39 @@ private:
 	};
 	boost::heap::priority_queue<CGPathNode *, boost::heap::compare<NodeComparer> > pq;
 
+	/// lower bound of path cost from any tile to destination of single path search
+	/// holds only while hero can't embark or disembark, as these moves may cost less than a single step
+	struct DestinationEstimate
+	{
+		static const int FAR_AWAY = std::numeric_limits<int>::max() / 4;
+
+		int3 dst;
+		std::vector<int3> portals; //tiles hero may be teleported from or to
+		int portalsToDestination; //steps from nearest portal to destination
+		float stepCost; //lowest cost of moving hero by one tile
+
+		float estimate(const int3 & tile) const;
+		static int steps(const int3 & from, const int3 & to); //moves needed to walk between tiles without obstacles
+	};
+
+	struct EstimatedNode
+	{
+		float priority; //cost of node plus estimate of remaining cost, at the moment node was queued
+		CGPathNode * node;
+	};
+
+	struct EstimatedNodeComparer
+	{
+		STRONG_INLINE
+		bool operator()(const EstimatedNode & lhs, const EstimatedNode & rhs) const
+		{
+			return lhs.priority > rhs.priority;
+		}
+	};
+
+	boost::optional<DestinationEstimate> destinationEstimate;
+	boost::heap::priority_queue<EstimatedNode, boost::heap::compare<EstimatedNodeComparer> > estimatedPq;
+
 	PathNodeInfo source; //current (source) path node -> we took it from the queue
 	CDestinationNodeInfo destination; //destination node -> it's a neighbour of source that we consider
 
@@ -441,6 +482,11 @@ private:
 
 	void initializePatrol();
 	void initializeGraph();
+
+	void search(const boost::optional<int3> & dst);
+	void pushNode(CGPathNode * node);
+	bool canEstimateDistance() const;
+	DestinationEstimate makeDestinationEstimate(const int3 & dst) const;
 };
 
 struct DLL_LINKAGE TurnInfo
@@ -10,41 +10,154 @@
 #include "StdInc.h"
 #include "CThreadHelper.h"
 
+#include "CConfigHandler.h"
+
 #ifdef VCMI_WINDOWS
 	#include <windows.h>
 #elif !defined(VCMI_APPLE) && !defined(VCMI_FREEBSD) && !defined(VCMI_HURD)
 	#include <sys/prctl.h>
 #endif
 
-CThreadHelper::CThreadHelper(std::vector<std::function<void()> > *Tasks, int Threads)
+CThreadPool::CThreadPool(ui32 threads)
+	: stopping(false)
 {
-	currentTask = 0; amount = Tasks->size();
-	tasks = Tasks;
-	threads = Threads;
+	for(ui32 i = 0; i < threads; i++)
+		workers.create_thread(std::bind(&CThreadPool::workerLoop, this));
 }
-void CThreadHelper::run()
+
+CThreadPool::~CThreadPool()
 {
-	boost::thread_group grupa;
-	for(int i=0;i<threads;i++)
-		grupa.create_thread(std::bind(&CThreadHelper::processTasks,this));
-	grupa.join_all();
+	{
+		boost::unique_lock<boost::mutex> lock(mx);
+		stopping = true;
+	}
+	wakeUp.notify_all();
+	workers.join_all();
+}
 
-	//thread group deletes threads, do not free manually
+CThreadPool & CThreadPool::get()
+{
+	static CThreadPool pool([]()
+	{
+		ui32 threads = settings["general"]["threads"].Integer();
+		if(threads == 0)
+			threads = boost::thread::hardware_concurrency();
+
+		//calling thread always takes part in the work as well
+		//but at least one worker is needed for asynchronous jobs
+		return std::max<ui32>(threads, 2) - 1;
+	}());
+	return pool;
+}
+
+ui32 CThreadPool::getThreadCount() const
+{
+	return workers.size() + 1;
 }
-void CThreadHelper::processTasks()
+
+void CThreadPool::workerLoop()
 {
-	while(true)
+	setThreadName("CThreadPool::workerLoop");
+
+	boost::unique_lock<boost::mutex> lock(mx);
+	while(!stopping)
 	{
-		int pom;
+		if(!runQueuedJob(lock))
+			wakeUp.wait(lock);
+	}
+}
+
+bool CThreadPool::runQueuedJob(boost::unique_lock<boost::mutex> & lock)
+{
+	if(jobs.empty())
+		return false;
+
+	Task job = std::move(jobs.front().task);
+	jobs.pop_front();
+
+	lock.unlock();
+	job();
+	lock.lock();
+	return true;
+}
+
+void CThreadPool::post(Task job)
+{
+	{
+		boost::unique_lock<boost::mutex> lock(mx);
+		jobs.push_back(Job{std::move(job), nullptr});
+	}
+	wakeUp.notify_one();
+}
+
+void CThreadPool::run(const std::vector<Task> & tasks)
+{
+	if(tasks.empty())
+		return;
+
+	std::atomic<size_t> nextTask(0);
+	size_t helpersLeft = std::min<size_t>(workers.size(), tasks.size() - 1);
+	std::exception_ptr error;
+	boost::mutex errorMx;
+
+	auto processTasks = [&]()
+	{
+		size_t current;
+		while((current = nextTask++) < tasks.size())
 		{
-			boost::unique_lock<boost::mutex> lock(rtinm);
-			if((pom = currentTask) >= amount)
-				break;
-			else
-				++currentTask;
+			try
+			{
+				tasks[current]();
+			}
+			catch(...)
+			{
+				boost::unique_lock<boost::mutex> lock(errorMx);
+				if(!error)
+					error = std::current_exception();
+			}
 		}
-		(*tasks)[pom]();
+	};
+
+	{
+		boost::unique_lock<boost::mutex> lock(mx);
+		for(size_t i = 0; i < helpersLeft; i++)
+		{
+			jobs.push_back(Job{[&]()
+			{
+				processTasks();
+
+				boost::unique_lock<boost::mutex> lock(mx);
+				helpersLeft--;
+				wakeUp.notify_all();
+			}, &nextTask});
+		}
+	}
+	wakeUp.notify_all();
+
+	processTasks();
+
+	// helpers reference this stack frame, so wait until all of them finish
+	// all tasks are already taken, so helpers that did not start yet have nothing to do and can be dropped
+	// this also keeps nested run() calls from workers from waiting for helpers that no thread is free to start
+	// other queued jobs are never executed here - they may need locks held by caller of run()
+	boost::unique_lock<boost::mutex> lock(mx);
+	for(auto it = jobs.begin(); it != jobs.end();)
+	{
+		if(it->batch == &nextTask)
+		{
+			it = jobs.erase(it);
+			helpersLeft--;
+		}
+		else
+			it++;
 	}
+
+	while(helpersLeft > 0)
+		wakeUp.wait(lock);
+	lock.unlock();
+
+	if(error)
+		std::rethrow_exception(error);
 }
 
 // set name for this thread.
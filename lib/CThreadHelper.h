@@ -9,21 +9,64 @@
  */
 #pragma once
 
+#include <future>
 
 typedef std::function<void()> Task;
 
-/// Can assign CPU work to other threads/cores
-class DLL_LINKAGE CThreadHelper
+/// Process-wide pool of worker threads that can assign CPU work to other threads/cores
+/// Threads are created once, on first use, and reused for all later work
+class DLL_LINKAGE CThreadPool : public boost::noncopyable
 {
-	boost::mutex rtinm;
-	int currentTask, amount, threads;
-	std::vector<Task> *tasks;
+	struct Job
+	{
+		Task task;
+		const void * batch; //run() call that queued this job, nullptr for posted jobs
+	};
 
+	boost::thread_group workers;
+	boost::mutex mx;
+	boost::condition_variable wakeUp; //signalled when new job is queued, stop is requested or a job is finished
+	std::deque<Job> jobs;
+	bool stopping;
 
-	void processTasks();
+	explicit CThreadPool(ui32 threads);
+
+	void workerLoop();
+	bool runQueuedJob(boost::unique_lock<boost::mutex> & lock); //pops and runs one job, returns false if there was none
+	void post(Task job);
 public:
-	CThreadHelper(std::vector<std::function<void()> > *Tasks, int Threads);
-	void run();
+	~CThreadPool();
+
+	/// Returns global pool, sized according to "general/threads" setting (0 or missing - number of CPU cores)
+	/// Pool always has at least one worker, so asynchronous jobs are executed even on single core
+	static CThreadPool & get();
+
+	ui32 getThreadCount() const;
+
+	/// Executes all tasks in parallel and waits for them, calling thread takes part in processing
+	/// While waiting calling thread never picks up unrelated queued jobs, so tasks may be run under locks
+	/// Rethrows first exception thrown by a task, if any
+	void run(const std::vector<Task> & tasks);
+
+	/// Calls func(i) for every i in [begin, end) in parallel
+	template<typename Func>
+	void parallelFor(size_t begin, size_t end, const Func & func)
+	{
+		std::vector<Task> tasks;
+		tasks.reserve(end - begin);
+		for(size_t i = begin; i < end; i++)
+			tasks.push_back([&func, i](){ func(i); });
+		run(tasks);
+	}
+
+	/// Executes task asynchronously, result is accessible via returned future
+	template<typename Func>
+	auto async(Func func) -> std::future<decltype(func())>
+	{
+		auto task = std::make_shared<std::packaged_task<decltype(func())()>>(std::move(func));
+		post([task](){ (*task)(); });
+		return task->get_future();
+	}
 };
 
 template <typename T> inline void setData(T * data, std::function<T()> func)
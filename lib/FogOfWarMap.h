@@ -0,0 +1,164 @@
+/*
+ * FogOfWarMap.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "int3.h"
+
+/// Visibility of map tiles for one team, stored as one bit per tile.
+/// Each row of the map starts in a new 64-bit word, so whole rows can be checked or changed with word operations.
+class FogOfWarMap
+{
+	typedef ui64 TWord;
+	static const int BITS_PER_WORD = 64;
+
+	int3 sizes; // width, height and number of levels
+	int wordsPerRow;
+	std::vector<TWord> bits;
+
+	size_t getWordIndex(const int3 & pos) const
+	{
+		return (static_cast<size_t>(pos.z) * sizes.y + pos.y) * wordsPerRow + pos.x / BITS_PER_WORD;
+	}
+
+	static TWord getBitMask(const int3 & pos)
+	{
+		return TWord(1) << (pos.x % BITS_PER_WORD);
+	}
+
+	/// calls func(word, mask) for every word covering tiles [from.x, toX] of the row
+	template<typename Word, typename Func>
+	static void forEachRowWord(Word * row, int fromX, int toX, const Func & func)
+	{
+		for(int x = fromX; x <= toX; )
+		{
+			const int firstBit = x % BITS_PER_WORD;
+			const int count = std::min(BITS_PER_WORD - firstBit, toX - x + 1);
+			const TWord mask = (count == BITS_PER_WORD ? ~TWord(0) : (TWord(1) << count) - 1) << firstBit;
+
+			if(!func(row[x / BITS_PER_WORD], mask))
+				return;
+			x += count;
+		}
+	}
+
+	void setAreaVisible(const int3 & center, int radius, int3::EDistanceFormula formula, bool visible)
+	{
+		if(center.z < 0 || center.z >= sizes.z || radius < 0)
+			return;
+
+		// tiles in range form a continuous span in every row, span is narrowing with distance from center row
+		int halfWidth = radius;
+		for(int dy = 0; dy <= radius; dy++)
+		{
+			while(halfWidth >= 0 && int3(0, 0, 0).dist(int3(halfWidth, dy, 0), formula) > static_cast<ui32>(radius))
+				halfWidth--;
+			if(halfWidth < 0)
+				break;
+
+			const int fromX = std::max(center.x - halfWidth, 0);
+			const int toX = std::min(center.x + halfWidth, sizes.x - 1);
+
+			for(int y : {center.y - dy, center.y + dy})
+			{
+				if(y >= 0 && y < sizes.y && fromX <= toX)
+					setRowVisible(int3(fromX, y, center.z), toX, visible);
+				if(dy == 0)
+					break;
+			}
+		}
+	}
+
+public:
+	FogOfWarMap() : wordsPerRow(0) {}
+
+	/// resizes map to given width, height and number of levels. All tiles become hidden
+	void resize(const int3 & newSizes)
+	{
+		sizes = newSizes;
+		wordsPerRow = (sizes.x + BITS_PER_WORD - 1) / BITS_PER_WORD;
+		bits.assign(static_cast<size_t>(wordsPerRow) * sizes.y * sizes.z, 0);
+	}
+
+	const int3 & getSizes() const
+	{
+		return sizes;
+	}
+
+	bool isVisible(const int3 & pos) const
+	{
+		return (bits[getWordIndex(pos)] & getBitMask(pos)) != 0;
+	}
+
+	void setVisible(const int3 & pos, bool visible)
+	{
+		if(visible)
+			bits[getWordIndex(pos)] |= getBitMask(pos);
+		else
+			bits[getWordIndex(pos)] &= ~getBitMask(pos);
+	}
+
+	/// returns true if every tile in range [from.x, to.x] of row from.y on level from.z is visible
+	bool isRowVisible(const int3 & from, int toX) const
+	{
+		bool result = true;
+		forEachRowWord(&bits[getWordIndex(int3(0, from.y, from.z))], from.x, toX, [&](TWord word, TWord mask)
+		{
+			result = (word & mask) == mask;
+			return result;
+		});
+		return result;
+	}
+
+	/// changes visibility of tiles in range [from.x, to.x] of row from.y on level from.z
+	void setRowVisible(const int3 & from, int toX, bool visible)
+	{
+		forEachRowWord(&bits[getWordIndex(int3(0, from.y, from.z))], from.x, toX, [=](TWord & word, TWord mask)
+		{
+			if(visible)
+				word |= mask;
+			else
+				word &= ~mask;
+			return true;
+		});
+	}
+
+	/// reveals all tiles on level of center within radius from it, same tiles getTilesInRange would select
+	void revealArea(const int3 & center, int radius, int3::EDistanceFormula formula = int3::DIST_2D)
+	{
+		setAreaVisible(center, radius, formula, true);
+	}
+
+	/// hides all tiles on level of center within radius from it
+	void hideArea(const int3 & center, int radius, int3::EDistanceFormula formula = int3::DIST_2D)
+	{
+		setAreaVisible(center, radius, formula, false);
+	}
+
+	/// converts visibility map stored as [x][y][z] array by old versions
+	void loadLegacy(const std::vector<std::vector<std::vector<ui8>>> & legacyMap)
+	{
+		const int width = legacyMap.size();
+		const int height = width ? legacyMap.front().size() : 0;
+		const int levels = height ? legacyMap.front().front().size() : 0;
+
+		resize(int3(width, height, levels));
+		for(int x = 0; x < width; x++)
+			for(int y = 0; y < height; y++)
+				for(int z = 0; z < levels; z++)
+					setVisible(int3(x, y, z), legacyMap[x][y][z]);
+	}
+
+	template <typename Handler> void serialize(Handler & h, const int version)
+	{
+		h & sizes;
+		h & wordsPerRow;
+		h & bits;
+	}
+};
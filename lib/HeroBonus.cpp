@@ -213,24 +213,17 @@ JsonNode CAddInfo::toJsonNode() const
 }
 
 std::atomic<int32_t> CBonusSystemNode::treeChanged(1);
+std::atomic<int32_t> CBonusSystemNode::lastGlobalChange(1);
 const bool CBonusSystemNode::cachingEnabled = true;
 
-BonusList::BonusList(bool BelongsToTree) : belongsToTree(BelongsToTree)
-{
-
-}
-
 BonusList::BonusList(const BonusList &bonusList)
 {
 	bonuses.resize(bonusList.size());
 	std::copy(bonusList.begin(), bonusList.end(), bonuses.begin());
-	belongsToTree = false;
 }
 
-BonusList::BonusList(BonusList&& other):
-	belongsToTree(false)
+BonusList::BonusList(BonusList&& other)
 {
-	std::swap(belongsToTree, other.belongsToTree);
 	std::swap(bonuses, other.bonuses);
 }
 
@@ -238,16 +231,9 @@ BonusList& BonusList::operator=(const BonusList &bonusList)
 {
 	bonuses.resize(bonusList.size());
 	std::copy(bonusList.begin(), bonusList.end(), bonuses.begin());
-	belongsToTree = false;
 	return *this;
 }
 
-void BonusList::changed()
-{
-    if(belongsToTree)
-		CBonusSystemNode::treeHasChanged();
-}
-
 void BonusList::stackBonuses()
 {
 	boost::sort(bonuses, [](std::shared_ptr<Bonus> b1, std::shared_ptr<Bonus> b2) -> bool
@@ -430,19 +416,16 @@ JsonNode BonusList::toJsonNode() const
 void BonusList::push_back(std::shared_ptr<Bonus> x)
 {
 	bonuses.push_back(x);
-	changed();
 }
 
 BonusList::TInternalContainer::iterator BonusList::erase(const int position)
 {
-	changed();
 	return bonuses.erase(bonuses.begin() + position);
 }
 
 void BonusList::clear()
 {
 	bonuses.clear();
-	changed();
 }
 
 std::vector<BonusList*>::size_type BonusList::operator-=(std::shared_ptr<Bonus> const &i)
@@ -451,20 +434,151 @@ std::vector<BonusList*>::size_type BonusList::operator-=(std::shared_ptr<Bonus>
 	if(itr == bonuses.end())
 		return false;
 	bonuses.erase(itr);
-	changed();
 	return true;
 }
 
 void BonusList::resize(BonusList::TInternalContainer::size_type sz, std::shared_ptr<Bonus> c )
 {
 	bonuses.resize(sz, c);
-	changed();
 }
 
 void BonusList::insert(BonusList::TInternalContainer::iterator position, BonusList::TInternalContainer::size_type n, std::shared_ptr<Bonus> const &x)
 {
 	bonuses.insert(position, n, x);
-	changed();
+}
+
+BonusCacheKey::BonusCacheKey()
+	: kind(NONE), category(0), subtype(0), info(0)
+{
+}
+
+BonusCacheKey::BonusCacheKey(EKind Kind, ui16 Category, si32 Subtype, si32 Info)
+	: kind(Kind), category(Category), subtype(Subtype), info(Info)
+{
+}
+
+BonusCacheKey BonusCacheKey::type(Bonus::BonusType type)
+{
+	return BonusCacheKey(TYPE, type, ANY_SUBTYPE);
+}
+
+BonusCacheKey BonusCacheKey::typeSubtype(Bonus::BonusType type, TBonusSubtype subtype)
+{
+	return BonusCacheKey(TYPE, type, subtype);
+}
+
+BonusCacheKey BonusCacheKey::typeSubtypeInfo(Bonus::BonusType type, TBonusSubtype subtype, si32 info)
+{
+	return BonusCacheKey(TYPE_INFO, type, subtype, info);
+}
+
+BonusCacheKey BonusCacheKey::sourceType(Bonus::BonusSource source)
+{
+	return BonusCacheKey(SOURCE_ANY_ID, source, 0);
+}
+
+BonusCacheKey BonusCacheKey::source(Bonus::BonusSource source, ui32 sourceID)
+{
+	return BonusCacheKey(SOURCE, source, static_cast<si32>(sourceID));
+}
+
+BonusCacheKey BonusCacheKey::unique()
+{
+	static std::atomic<si32> lastID(0);
+	return BonusCacheKey(UNIQUE, 0, ++lastID);
+}
+
+bool BonusCacheKey::empty() const
+{
+	return kind == NONE;
+}
+
+size_t BonusCacheKey::hash() const
+{
+	ui64 packed = (static_cast<ui64>(kind) << 48) | (static_cast<ui64>(category) << 32) | static_cast<ui32>(subtype);
+	packed ^= static_cast<ui64>(static_cast<ui32>(info)) * 0x9E3779B97F4A7C15ULL;
+
+	//fmix64 from MurmurHash3, keys differ mostly in low bits of subtype
+	packed ^= packed >> 33;
+	packed *= 0xFF51AFD7ED558CCDULL;
+	packed ^= packed >> 33;
+	packed *= 0xC4CEB9FE1A85EC53ULL;
+	packed ^= packed >> 33;
+	return static_cast<size_t>(packed);
+}
+
+bool BonusCacheKey::operator==(const BonusCacheKey & other) const
+{
+	return kind == other.kind && category == other.category && subtype == other.subtype && info == other.info;
+}
+
+bool BonusCacheKey::operator!=(const BonusCacheKey & other) const
+{
+	return !(*this == other);
+}
+
+BonusQueryCache::BonusQueryCache()
+	: used(0)
+{
+}
+
+TBonusListPtr BonusQueryCache::find(const BonusCacheKey & key) const
+{
+	if(entries.empty())
+		return nullptr;
+
+	return entries[slotFor(key)].value;
+}
+
+void BonusQueryCache::insert(const BonusCacheKey & key, TBonusListPtr value)
+{
+	assert(!key.empty());
+
+	//keep load factor below 1/2 so probing sequences stay short
+	if(2 * (used + 1) > entries.size())
+		grow();
+
+	Entry & entry = entries[slotFor(key)];
+	if(entry.key.empty())
+		used++;
+	entry.key = key;
+	entry.value = value;
+}
+
+void BonusQueryCache::clear()
+{
+	if(used == 0)
+		return;
+
+	for(Entry & entry : entries)
+	{
+		entry.key = BonusCacheKey();
+		entry.value.reset();
+	}
+	used = 0;
+}
+
+size_t BonusQueryCache::slotFor(const BonusCacheKey & key) const
+{
+	const size_t mask = entries.size() - 1;
+	size_t slot = key.hash() & mask;
+
+	while(!entries[slot].key.empty() && entries[slot].key != key)
+		slot = (slot + 1) & mask;
+
+	return slot;
+}
+
+void BonusQueryCache::grow()
+{
+	std::vector<Entry> old;
+	std::swap(old, entries);
+	entries.resize(std::max<size_t>(16, old.size() * 2));
+	used = 0;
+
+	for(Entry & entry : old)
+		if(!entry.key.empty())
+			insert(entry.key, entry.value);
 }
 
 int IBonusBearer::valOfBonuses(Bonus::BonusType type, const CSelector &selector) const
@@ -474,60 +588,51 @@ int IBonusBearer::valOfBonuses(Bonus::BonusType type, const CSelector &selector)
 
 int IBonusBearer::valOfBonuses(Bonus::BonusType type, int subtype) const
 {
-	boost::format fmt("type_%ds_%d");
-	fmt % (int)type % subtype;
-
 	CSelector s = Selector::type(type);
 	if(subtype != -1)
 		s = s.And(Selector::subtype(subtype));
 
-	return valOfBonuses(s, fmt.str());
+	return valOfBonuses(s, BonusCacheKey::typeSubtype(type, subtype));
 }
 
-int IBonusBearer::valOfBonuses(const CSelector &selector, const std::string &cachingStr) const
+int IBonusBearer::valOfBonuses(const CSelector &selector, const BonusCacheKey &cachingKey) const
 {
 	CSelector limit = nullptr;
-	TBonusListPtr hlp = getAllBonuses(selector, limit, nullptr, cachingStr);
+	TBonusListPtr hlp = getAllBonuses(selector, limit, nullptr, cachingKey);
 	return hlp->totalValue();
 }
-bool IBonusBearer::hasBonus(const CSelector &selector, const std::string &cachingStr) const
+bool IBonusBearer::hasBonus(const CSelector &selector, const BonusCacheKey &cachingKey) const
 {
-	return getBonuses(selector, cachingStr)->size() > 0;
+	return getBonuses(selector, cachingKey)->size() > 0;
 }
 
-bool IBonusBearer::hasBonus(const CSelector &selector, const CSelector &limit, const std::string &cachingStr) const
+bool IBonusBearer::hasBonus(const CSelector &selector, const CSelector &limit, const BonusCacheKey &cachingKey) const
 {
-	return getBonuses(selector, limit, cachingStr)->size() > 0;
+	return getBonuses(selector, limit, cachingKey)->size() > 0;
 }
 
 bool IBonusBearer::hasBonusOfType(Bonus::BonusType type, int subtype) const
 {
-	boost::format fmt("type_%ds_%d");
-	fmt % (int)type % subtype;
-
 	CSelector s = Selector::type(type);
 	if(subtype != -1)
 		s = s.And(Selector::subtype(subtype));
 
-	return hasBonus(s, fmt.str());
+	return hasBonus(s, BonusCacheKey::typeSubtype(type, subtype));
 }
 
-const TBonusListPtr IBonusBearer::getBonuses(const CSelector &selector, const std::string &cachingStr) const
+const TBonusListPtr IBonusBearer::getBonuses(const CSelector &selector, const BonusCacheKey &cachingKey) const
 {
-	return getAllBonuses(selector, nullptr, nullptr, cachingStr);
+	return getAllBonuses(selector, nullptr, nullptr, cachingKey);
 }
 
-const TBonusListPtr IBonusBearer::getBonuses(const CSelector &selector, const CSelector &limit, const std::string &cachingStr) const
+const TBonusListPtr IBonusBearer::getBonuses(const CSelector &selector, const CSelector &limit, const BonusCacheKey &cachingKey) const
 {
-	return getAllBonuses(selector, limit, nullptr, cachingStr);
+	return getAllBonuses(selector, limit, nullptr, cachingKey);
 }
 
 bool IBonusBearer::hasBonusFrom(Bonus::BonusSource source, ui32 sourceID) const
 {
-	boost::format fmt("source_%did_%d");
-	fmt % (int)source % sourceID;
-
-	return hasBonus(Selector::source(source,sourceID), fmt.str());
+	return hasBonus(Selector::source(source,sourceID), BonusCacheKey::source(source, sourceID));
 }
 
 int IBonusBearer::MoraleVal() const
@@ -559,42 +664,42 @@ int IBonusBearer::LuckVal() const
 
 ui32 IBonusBearer::MaxHealth() const
 {
-	const std::string cachingStr = "type_STACK_HEALTH";
+	static const auto cachingKey = BonusCacheKey::type(Bonus::STACK_HEALTH);
 	static const auto selector = Selector::type(Bonus::STACK_HEALTH);
-	auto value = valOfBonuses(selector, cachingStr);
+	auto value = valOfBonuses(selector, cachingKey);
 	return std::max(1, value); //never 0
 }
 
 int IBonusBearer::getAttack(bool ranged) const
 {
-	const std::string cachingStr = "type_PRIMARY_SKILLs_ATTACK";
+	static const auto cachingKey = BonusCacheKey::typeSubtype(Bonus::PRIMARY_SKILL, PrimarySkill::ATTACK);
 
 	static const auto selector = Selector::typeSubtype(Bonus::PRIMARY_SKILL, PrimarySkill::ATTACK);
 
-	return getBonuses(selector, nullptr, cachingStr)->totalValue();
+	return getBonuses(selector, nullptr, cachingKey)->totalValue();
 }
 
 int IBonusBearer::getDefence(bool ranged) const
 {
-	const std::string cachingStr = "type_PRIMARY_SKILLs_DEFENSE";
+	static const auto cachingKey = BonusCacheKey::typeSubtype(Bonus::PRIMARY_SKILL, PrimarySkill::DEFENSE);
 
 	static const auto selector = Selector::typeSubtype(Bonus::PRIMARY_SKILL, PrimarySkill::DEFENSE);
 
-	return getBonuses(selector, nullptr, cachingStr)->totalValue();
+	return getBonuses(selector, nullptr, cachingKey)->totalValue();
 }
 
 int IBonusBearer::getMinDamage(bool ranged) const
 {
-	const std::string cachingStr = "type_CREATURE_DAMAGEs_0Otype_CREATURE_DAMAGEs_1";
+	static const auto cachingKey = BonusCacheKey::unique();
 	static const auto selector = Selector::typeSubtype(Bonus::CREATURE_DAMAGE, 0).Or(Selector::typeSubtype(Bonus::CREATURE_DAMAGE, 1));
-	return valOfBonuses(selector, cachingStr);
+	return valOfBonuses(selector, cachingKey);
 }
 
 int IBonusBearer::getMaxDamage(bool ranged) const
 {
-	const std::string cachingStr = "type_CREATURE_DAMAGEs_0Otype_CREATURE_DAMAGEs_2";
+	static const auto cachingKey = BonusCacheKey::unique();
 	static const auto selector = Selector::typeSubtype(Bonus::CREATURE_DAMAGE, 0).Or(Selector::typeSubtype(Bonus::CREATURE_DAMAGE, 2));
-	return valOfBonuses(selector, cachingStr);
+	return valOfBonuses(selector, cachingKey);
 }
 
 si32 IBonusBearer::manaLimit() const
@@ -607,7 +712,7 @@ si32 IBonusBearer::manaLimit() const
 int IBonusBearer::getPrimSkillLevel(PrimarySkill::PrimarySkill id) const
 {
 	static const CSelector selectorAllSkills = Selector::type(Bonus::PRIMARY_SKILL);
-	static const std::string keyAllSkills = "type_PRIMARY_SKILL";
+	static const auto keyAllSkills = BonusCacheKey::type(Bonus::PRIMARY_SKILL);
 
 	auto allSkills = getBonuses(selectorAllSkills, keyAllSkills);
 
@@ -640,13 +745,13 @@ ui32 IBonusBearer::Speed(int turn, bool useBind) const
 
 bool IBonusBearer::isLiving() const //TODO: theoreticaly there exists "LIVING" bonus in stack experience documentation
 {
-	static const std::string cachingStr = "IBonusBearer::isLiving";
+	static const auto cachingKey = BonusCacheKey::unique();
 	static const CSelector selector = Selector::type(Bonus::UNDEAD)
 		.Or(Selector::type(Bonus::NON_LIVING))
 		.Or(Selector::type(Bonus::GARGOYLE))
 		.Or(Selector::type(Bonus::SIEGE_WEAPON));
 
-	return !hasBonus(selector, cachingStr);
+	return !hasBonus(selector, cachingKey);
 }
 
 const std::shared_ptr<Bonus> IBonusBearer::getBonus(const CSelector &selector) const
@@ -720,7 +825,7 @@ void CBonusSystemNode::getAllBonusesRec(BonusList &out) const
 		out.push_back(update(b));
 }
 
-const TBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, const CSelector &limit, const CBonusSystemNode *root, const std::string &cachingStr) const
+const TBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, const CSelector &limit, const CBonusSystemNode *root, const BonusCacheKey &cachingKey) const
 {
 	bool limitOnUs = (!root || root == this); //caching won't work when we want to limit bonuses against an external node
 	if (CBonusSystemNode::cachingEnabled && limitOnUs)
@@ -729,9 +834,10 @@ const TBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, c
 		static boost::mutex m;
 		boost::mutex::scoped_lock lock(m);
 
-		// If the bonus system tree changes(state of a single node or the relations to each other) then
+		// If this node or any of its ancestors changed (state of a single node or the relations to each other) then
 		// cache all bonus objects. Selector objects doesn't matter.
-		if (cachedLast != treeChanged)
+		const int64_t treeVersion = CBonusSystemNode::getTreeVersion();
+		if (cachedLast != treeVersion)
 		{
 			cachedBonuses.clear();
 			cachedRequests.clear();
@@ -741,18 +847,18 @@ const TBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, c
 			limitBonuses(allBonuses, cachedBonuses);
 			cachedBonuses.stackBonuses();
 
-			cachedLast = treeChanged;
+			cachedLast = treeVersion;
 		}
 
-		// If a bonus system request comes with a caching string then look up in the map if there are any
+		// If a bonus system request comes with a caching key then look up in the cache if there are any
 		// pre-calculated bonus results. Limiters can't be cached so they have to be calculated.
-		if (cachingStr != "")
+		if (!cachingKey.empty())
 		{
-			auto it = cachedRequests.find(cachingStr);
-			if(it != cachedRequests.end())
+			auto cached = cachedRequests.find(cachingKey);
+			if(cached)
 			{
 				//Cached list contains bonuses for our query with applied limiters
-				return it->second;
+				return cached;
 			}
 		}
 
@@ -762,8 +868,8 @@ const TBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, c
 		cachedBonuses.getBonuses(*ret, selector, limit);
 
 		// Save the results in the cache
-		if(cachingStr != "")
-			cachedRequests[cachingStr] = ret;
+		if(!cachingKey.empty())
+			cachedRequests.insert(cachingKey, ret);
 
 		return ret;
 	}
@@ -815,18 +921,16 @@ const std::shared_ptr<Bonus> CBonusSystemNode::update(const std::shared_ptr<Bonu
 }
 
 CBonusSystemNode::CBonusSystemNode()
-	: bonuses(true),
-	exportedBonuses(true),
-	nodeType(UNKNOWN),
-	cachedLast(0)
+	: nodeType(UNKNOWN),
+	cachedLast(0),
+	nodeChanged(0)
 {
 }
 
 CBonusSystemNode::CBonusSystemNode(ENodeTypes NodeType)
-	: bonuses(true),
-	exportedBonuses(true),
-	nodeType(NodeType),
-	cachedLast(0)
+	: nodeType(NodeType),
+	cachedLast(0),
+	nodeChanged(0)
 {
 }
 
@@ -835,7 +939,8 @@ CBonusSystemNode::CBonusSystemNode(CBonusSystemNode && other):
 	exportedBonuses(std::move(other.exportedBonuses)),
 	nodeType(other.nodeType),
 	description(other.description),
-	cachedLast(0)
+	cachedLast(0),
+	nodeChanged(other.nodeChanged)
 {
 	std::swap(parents, other.parents);
 	std::swap(children, other.children);
@@ -882,7 +987,7 @@ void CBonusSystemNode::attachTo(CBonusSystemNode *parent)
 		newRedDescendant(parent);
 
 	parent->newChildAttached(this);
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::detachFrom(CBonusSystemNode *parent)
@@ -896,7 +1001,7 @@ void CBonusSystemNode::detachFrom(CBonusSystemNode *parent)
 
 	parents -= parent;
 	parent->childDetached(this);
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::removeBonusesRecursive(const CSelector & s)
@@ -932,14 +1037,19 @@ void CBonusSystemNode::addNewBonus(const std::shared_ptr<Bonus>& b)
 	assert(!vstd::contains(exportedBonuses, b));
 	exportedBonuses.push_back(b);
 	exportBonus(b);
-	CBonusSystemNode::treeHasChanged();
 }
 
 void CBonusSystemNode::accumulateBonus(const std::shared_ptr<Bonus>& b)
 {
 	auto bonus = exportedBonuses.getFirst(Selector::typeSubtype(b->type, b->subtype)); //only local bonuses are interesting //TODO: what about value type?
 	if(bonus)
+	{
 		bonus->val += b->val;
+		if(bonus->propagator)
+			CBonusSystemNode::treeHasChanged(); //bonus may be attached anywhere among red descendants
+		else
+			nodeHasChanged();
+	}
 	else
 		addNewBonus(std::make_shared<Bonus>(*b)); //duplicate needed, original may get destroyed
 }
@@ -948,10 +1058,14 @@ void CBonusSystemNode::removeBonus(const std::shared_ptr<Bonus>& b)
 {
 	exportedBonuses -= b;
 	if(b->propagator)
+	{
 		unpropagateBonus(b);
+	}
 	else
+	{
 		bonuses -= b;
-	CBonusSystemNode::treeHasChanged();
+		nodeHasChanged();
+	}
 }
 
 void CBonusSystemNode::removeBonuses(const CSelector & selector)
@@ -980,6 +1094,7 @@ void CBonusSystemNode::propagateBonus(std::shared_ptr<Bonus> b)
 	if(b->propagator->shouldBeAttached(this))
 	{
 		bonuses.push_back(b);
+		nodeHasChanged();
 		logBonus->trace("#$# %s #propagated to# %s",  b->Description(), nodeName());
 	}
 
@@ -992,6 +1107,7 @@ void CBonusSystemNode::unpropagateBonus(std::shared_ptr<Bonus> b)
 	if(b->propagator->shouldBeAttached(this))
 	{
 		bonuses -= b;
+		nodeHasChanged();
 		logBonus->trace("#$# %s #is no longer propagated to# %s",  b->Description(), nodeName());
 	}
 
@@ -1116,11 +1232,14 @@ void CBonusSystemNode::getRedDescendants(TNodes &out)
 void CBonusSystemNode::exportBonus(std::shared_ptr<Bonus> b)
 {
 	if(b->propagator)
+	{
 		propagateBonus(b);
+	}
 	else
+	{
 		bonuses.push_back(b);
-
-	CBonusSystemNode::treeHasChanged();
+		nodeHasChanged();
+	}
 }
 
 void CBonusSystemNode::exportBonuses()
@@ -1213,12 +1332,30 @@ TBonusListPtr CBonusSystemNode::limitBonuses(const BonusList &allBonuses) const
 
 void CBonusSystemNode::treeHasChanged()
 {
-	treeChanged++;
+	lastGlobalChange = ++treeChanged;
+}
+
+void CBonusSystemNode::nodeHasChanged()
+{
+	invalidateChildren(++treeChanged);
+}
+
+void CBonusSystemNode::invalidateChildren(int32_t version)
+{
+	//children inherit our bonuses, so their caches depend on us
+	//each change gets unique version so every node is visited only once even if reachable by several paths
+	if(nodeChanged == version)
+		return;
+
+	nodeChanged = version;
+
+	for(CBonusSystemNode * child : children)
+		child->invalidateChildren(version);
 }
 
 int64_t CBonusSystemNode::getTreeVersion() const
 {
-	int64_t ret = treeChanged;
+	int64_t ret = std::max<int32_t>(nodeChanged, lastGlobalChange);
 	return ret << 32;
 }
 
@@ -479,8 +479,6 @@ public:
 
 private:
 	TInternalContainer bonuses;
-	bool belongsToTree;
-	void changed();
 
 public:
 	typedef TInternalContainer::const_reference const_reference;
@@ -489,7 +487,7 @@ public:
 	typedef TInternalContainer::const_iterator const_iterator;
 	typedef TInternalContainer::iterator iterator;
 
-	BonusList(bool BelongsToTree = false);
+	BonusList() = default;
 	BonusList(const BonusList &bonusList);
 	BonusList(BonusList && other);
 	BonusList& operator=(const BonusList &bonusList);
@@ -591,6 +589,69 @@ inline BonusList::const_iterator range_end(BonusList const &x)
 
 DLL_LINKAGE std::ostream & operator<<(std::ostream &out, const BonusList &bonusList);
 
+/// Identifies result of cached bonus query, must describe selector (and limit) of query unambiguously
+class DLL_LINKAGE BonusCacheKey
+{
+public:
+	///subtype value of keys for queries that select bonuses of any subtype, same as -1 in IBonusBearer::valOfBonuses(type, subtype)
+	static const TBonusSubtype ANY_SUBTYPE = -1;
+
+	BonusCacheKey(); //empty key, query result won't be cached
+
+	static BonusCacheKey type(Bonus::BonusType type); //same key as typeSubtype(type, ANY_SUBTYPE)
+	///query of bonuses with given type and subtype, ANY_SUBTYPE if query does not check subtype
+	static BonusCacheKey typeSubtype(Bonus::BonusType type, TBonusSubtype subtype);
+	///query of bonuses with given type, subtype and additional info, all of them compared exactly (ANY_SUBTYPE is not special here)
+	static BonusCacheKey typeSubtypeInfo(Bonus::BonusType type, TBonusSubtype subtype, si32 info);
+	static BonusCacheKey sourceType(Bonus::BonusSource source);
+	static BonusCacheKey source(Bonus::BonusSource source, ui32 sourceID);
+	///for queries that can't be described by type/source, returned key should be created once and stored in static variable
+	static BonusCacheKey unique();
+
+	bool empty() const;
+	size_t hash() const;
+
+	bool operator==(const BonusCacheKey & other) const;
+	bool operator!=(const BonusCacheKey & other) const;
+
+private:
+	enum EKind : ui8
+	{
+		NONE, TYPE, TYPE_INFO, SOURCE, SOURCE_ANY_ID, UNIQUE
+	};
+
+	EKind kind;
+	ui16 category; //bonus type or bonus source
+	si32 subtype; //subtype, source id or unique id
+	si32 info;
+
+	BonusCacheKey(EKind Kind, ui16 Category, si32 Subtype, si32 Info = 0);
+};
+
+/// Open addressing hash table for results of bonus queries
+class DLL_LINKAGE BonusQueryCache
+{
+public:
+	BonusQueryCache();
+
+	TBonusListPtr find(const BonusCacheKey & key) const; //returns nullptr if not found
+	void insert(const BonusCacheKey & key, TBonusListPtr value);
+	void clear(); //keeps allocated table for reuse
+
+private:
+	struct Entry
+	{
+		BonusCacheKey key;
+		TBonusListPtr value;
+	};
+
+	std::vector<Entry> entries; //size is always power of 2
+	size_t used;
+
+	size_t slotFor(const BonusCacheKey & key) const; //first slot with given or empty key
+	void grow();
+};
+
 class DLL_LINKAGE IPropagator
 {
 public:
@@ -646,12 +707,12 @@ public:
 	// * selector is predicate that tests if HeroBonus matches our criteria
 	// * root is node on which call was made (nullptr will be replaced with this)
 	//interface
-	virtual const TBonusListPtr getAllBonuses(const CSelector &selector, const CSelector &limit, const CBonusSystemNode *root = nullptr, const std::string &cachingStr = "") const = 0;
-	int valOfBonuses(const CSelector &selector, const std::string &cachingStr = "") const;
-	bool hasBonus(const CSelector &selector, const std::string &cachingStr = "") const;
-	bool hasBonus(const CSelector &selector, const CSelector &limit, const std::string &cachingStr = "") const;
-	const TBonusListPtr getBonuses(const CSelector &selector, const CSelector &limit, const std::string &cachingStr = "") const;
-	const TBonusListPtr getBonuses(const CSelector &selector, const std::string &cachingStr = "") const;
+	virtual const TBonusListPtr getAllBonuses(const CSelector &selector, const CSelector &limit, const CBonusSystemNode *root = nullptr, const BonusCacheKey &cachingKey = BonusCacheKey()) const = 0;
+	int valOfBonuses(const CSelector &selector, const BonusCacheKey &cachingKey = BonusCacheKey()) const;
+	bool hasBonus(const CSelector &selector, const BonusCacheKey &cachingKey = BonusCacheKey()) const;
+	bool hasBonus(const CSelector &selector, const CSelector &limit, const BonusCacheKey &cachingKey = BonusCacheKey()) const;
+	const TBonusListPtr getBonuses(const CSelector &selector, const CSelector &limit, const BonusCacheKey &cachingKey = BonusCacheKey()) const;
+	const TBonusListPtr getBonuses(const CSelector &selector, const BonusCacheKey &cachingKey = BonusCacheKey()) const;
 
 	const std::shared_ptr<Bonus> getBonus(const CSelector &selector) const; //returns any bonus visible on node that matches (or nullptr if none matches)
 
@@ -703,17 +764,19 @@ private:
 	static const bool cachingEnabled;
 	mutable BonusList cachedBonuses;
 	mutable int64_t cachedLast;
-	static std::atomic<int32_t> treeChanged;
+	static std::atomic<int32_t> treeChanged; //source of version numbers, incremented on every change anywhere in the tree
+	static std::atomic<int32_t> lastGlobalChange; //version of the last change that invalidated all nodes at once
+	int32_t nodeChanged; //version of the last change of this node or any of its ancestors
 
-	// Setting a value to cachingStr before getting any bonuses caches the result for later requests.
-	// This string needs to be unique, that's why it has to be setted in the following manner:
-	// [property key]_[value] => only for selector
-	mutable std::map<std::string, TBonusListPtr > cachedRequests;
+	// Passing a non-empty cachingKey when getting bonuses caches the result for later requests.
+	// The key needs to describe the selector unambiguously, see BonusCacheKey.
+	mutable BonusQueryCache cachedRequests;
 
 	void getBonusesRec(BonusList &out, const CSelector &selector, const CSelector &limit) const;
 	void getAllBonusesRec(BonusList &out) const;
 	const TBonusListPtr getAllBonusesWithoutCaching(const CSelector &selector, const CSelector &limit, const CBonusSystemNode *root = nullptr) const;
 	const std::shared_ptr<Bonus> update(const std::shared_ptr<Bonus> b) const;
+	void invalidateChildren(int32_t version);
 
 public:
 	explicit CBonusSystemNode();
@@ -723,7 +786,7 @@ public:
 
 	void limitBonuses(const BonusList &allBonuses, BonusList &out) const; //out will bo populed with bonuses that are not limited here
 	TBonusListPtr limitBonuses(const BonusList &allBonuses) const; //same as above, returns out by val for convienence
-	const TBonusListPtr getAllBonuses(const CSelector &selector, const CSelector &limit, const CBonusSystemNode *root = nullptr, const std::string &cachingStr = "") const override;
+	const TBonusListPtr getAllBonuses(const CSelector &selector, const CSelector &limit, const CBonusSystemNode *root = nullptr, const BonusCacheKey &cachingKey = BonusCacheKey()) const override;
 	void getParents(TCNodes &out) const;  //retrieves list of parent nodes (nodes to inherit bonuses from),
 	const std::shared_ptr<Bonus> getBonusLocalFirst(const CSelector &selector) const;
 
@@ -771,7 +834,8 @@ public:
 	const std::string &getDescription() const;
 	void setDescription(const std::string &description);
 
-	static void treeHasChanged();
+	static void treeHasChanged(); //invalidates caches of all nodes, use only when the changed node is not known
+	void nodeHasChanged(); //invalidates caches of this node and all its descendants
 
 	int64_t getTreeVersion() const override;
 
@@ -1101,7 +1165,6 @@ template <class InputIterator>
 void BonusList::insert(const int position, InputIterator first, InputIterator last)
 {
 	bonuses.insert(bonuses.begin() + position, first, last);
-	changed();
 }
 
 // observers for updating bonuses based on certain events (e.g. hero gaining level)
@@ -77,8 +77,8 @@ void CPrivilegedInfoCallback::getTilesInRange(std::unordered_set<int3, ShashInt3
 				if(distance <= radious)
 				{
 					if(!player
-						|| (mode == 1  && team->fogOfWarMap[xd][yd][pos.z]==0)
-						|| (mode == -1 && team->fogOfWarMap[xd][yd][pos.z]==1)
+						|| (mode == 1  && !team->fogOfWarMap.isVisible(tilePos))
+						|| (mode == -1 && team->fogOfWarMap.isVisible(tilePos))
 					)
 						tiles.insert(int3(xd,yd,pos.z));
 				}
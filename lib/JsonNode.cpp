@@ -87,6 +87,15 @@ JsonNode::JsonNode(const JsonNode &copy):
 	}
 }
 
+JsonNode::JsonNode(JsonNode &&other) noexcept:
+	type(other.type),
+	data(other.data),
+	meta(std::move(other.meta)),
+	flags(std::move(other.flags))
+{
+	other.type = JsonType::DATA_NULL;
+}
+
 JsonNode::~JsonNode()
 {
 	setType(JsonType::DATA_NULL);
@@ -135,7 +144,7 @@ JsonNode::JsonType JsonNode::getType() const
 	return type;
 }
 
-void JsonNode::setMeta(std::string metadata, bool recursive)
+void JsonNode::setMeta(const std::string & metadata, bool recursive)
 {
 	meta = metadata;
 	if (recursive)
@@ -224,7 +233,7 @@ bool JsonNode::containsBaseData() const
 	case JsonType::DATA_NULL:
 		return false;
 	case JsonType::DATA_STRUCT:
-		for(auto elem : *data.Struct)
+		for(const auto & elem : *data.Struct)
 		{
 			if(elem.second.containsBaseData())
 				return true;
@@ -900,6 +909,9 @@ const JsonNode & getSchemaByName(std::string name)
 {
 	// cached schemas to avoid loading json data multiple times
 	static std::map<std::string, JsonNode> loadedSchemas;
+	// mod data is validated from multiple threads
+	static boost::mutex loadedSchemasMutex;
+	boost::lock_guard<boost::mutex> lock(loadedSchemasMutex);
 
 	if (vstd::contains(loadedSchemas, name))
 		return loadedSchemas[name];
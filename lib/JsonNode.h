@@ -62,6 +62,8 @@ public:
 	explicit JsonNode(ResourceID && fileURI, bool & isValidSyntax);
 	//Copy c-tor
 	JsonNode(const JsonNode &copy);
+	//Move c-tor, leaves source node empty. Allows containers to relocate nodes without copying whole subtrees
+	JsonNode(JsonNode &&other) noexcept;
 
 	~JsonNode();
 
@@ -71,7 +73,7 @@ public:
 	bool operator == (const JsonNode &other) const;
 	bool operator != (const JsonNode &other) const;
 
-	void setMeta(std::string metadata, bool recursive = true);
+	void setMeta(const std::string & metadata, bool recursive = true);
 
 	/// Convert node to another type. Converting to nullptr will clear all data
 	void setType(JsonType Type);
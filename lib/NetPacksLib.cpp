@@ -178,10 +178,9 @@ DLL_LINKAGE void FoWChange::applyGs(CGameState *gs)
 {
 	TeamState * team = gs->getPlayerTeam(player);
 	for(int3 t : tiles)
-		team->fogOfWarMap[t.x][t.y][t.z] = mode;
+		team->fogOfWarMap.setVisible(t, mode);
 	if (mode == 0) //do not hide too much
 	{
-		std::unordered_set<int3, ShashInt3> tilesRevealed;
 		for (auto & elem : gs->map->objects)
 		{
 			const CGObjectInstance *o = elem;
@@ -194,13 +193,11 @@ DLL_LINKAGE void FoWChange::applyGs(CGameState *gs)
 				case Obj::TOWN:
 				case Obj::ABANDONED_MINE:
 					if(vstd::contains(team->players, o->tempOwner)) //check owned observators
-						gs->getTilesInRange(tilesRevealed, o->getSightCenter(), o->getSightRadius(), o->tempOwner, 1);
+						team->fogOfWarMap.revealArea(o->getSightCenter(), o->getSightRadius());
 					break;
 				}
 			}
 		}
-		for(int3 t : tilesRevealed) //probably not the most optimal solution ever
-			team->fogOfWarMap[t.x][t.y][t.z] = 1;
 	}
 }
 
@@ -550,7 +547,7 @@ void TryMoveHero::applyGs(CGameState *gs)
 	}
 
 	for(int3 t : fowRevealed)
-		gs->getPlayerTeam(h->getOwner())->fogOfWarMap[t.x][t.y][t.z] = 1;
+		gs->getPlayerTeam(h->getOwner())->fogOfWarMap.setVisible(t, true);
 }
 
 DLL_LINKAGE void NewStructures::applyGs(CGameState *gs)
@@ -994,7 +991,8 @@ DLL_LINKAGE void RebalanceStacks::applyGs(CGameState * gs)
 		}
 	}
 
-	CBonusSystemNode::treeHasChanged();
+	src.army->nodeHasChanged();
+	dst.army->nodeHasChanged();
 }
 
 DLL_LINKAGE void PutArtifact::applyGs(CGameState *gs)
@@ -1357,8 +1355,6 @@ void BattleResult::applyGs(CGameState *gs)
 		for(int i = 0; i < 2; i++)
 			if(exp[i])
 				gs->curB->battleGetArmyObject(i)->giveStackExp(exp[i]);
-
-		CBonusSystemNode::treeHasChanged();
 	}
 
 	for(int i = 0; i < 2; i++)
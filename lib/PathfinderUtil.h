@@ -11,16 +11,17 @@
 
 #include "mapping/CMapDefines.h"
 #include "CGameState.h"
+#include "FogOfWarMap.h"
 
 namespace PathfinderUtil
 {
-	using FoW = std::vector<std::vector<std::vector<ui8> > >;
+	using FoW = FogOfWarMap;
 	using ELayer = EPathfindingLayer;
 
 	template<EPathfindingLayer::EEPathfindingLayer layer>
 	CGPathNode::EAccessibility evaluateAccessibility(const int3 & pos, const TerrainTile * tinfo, const FoW & fow, const PlayerColor player, const CGameState * gs)
 	{
-		if(!fow[pos.x][pos.y][pos.z])
+		if(!fow.isVisible(pos))
 			return CGPathNode::BLOCKED;
 
 		switch(layer)
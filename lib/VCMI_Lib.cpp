@@ -30,9 +30,54 @@
 #include "CConsoleHandler.h"
 #include "rmg/CRmgTemplateStorage.h"
 #include "mapping/CMapEditManager.h"
+#include "serializer/BinaryDeserializer.h"
+#include "serializer/BinarySerializer.h"
+#include "serializer/CMemorySerializer.h"
 
 LibClasses * VLC = nullptr;
 
+static const std::string CONTENT_CACHE_MAGIC = "VCMI content cache";
+
+static boost::filesystem::path getContentCachePath()
+{
+	return VCMIDirs::get().userCachePath() / "contentCache.vcmi";
+}
+
+/// version string does not change between development builds, so main library file is used to tell builds apart as well
+static std::string getBuildIdentifier()
+{
+#ifdef VCMI_WINDOWS
+	const auto libraryPath = VCMIDirs::get().libraryPath() / VCMIDirs::get().libraryName("VCMI_lib");
+#else
+	const auto libraryPath = VCMIDirs::get().libraryPath() / VCMIDirs::get().libraryName("vcmi");
+#endif
+	std::string ret = GameConstants::VCMI_VERSION;
+
+	// missing library (e.g. static build) leaves only version
+	boost::system::error_code ec;
+	const auto size = boost::filesystem::file_size(libraryPath, ec);
+	if(!ec)
+		ret += " " + std::to_string(size);
+
+	const auto time = boost::filesystem::last_write_time(libraryPath, ec);
+	if(!ec)
+		ret += " " + std::to_string(time);
+
+	return ret;
+}
+
+static ui32 getContentCacheKey(const CModHandler & modh)
+{
+	const ui32 contentChecksum = modh.getContentChecksum();
+	const std::string buildId = getBuildIdentifier();
+
+	boost::crc_32_type key;
+	key.process_bytes(reinterpret_cast<const void *>(&contentChecksum), sizeof(contentChecksum));
+	key.process_bytes(reinterpret_cast<const void *>(&SERIALIZATION_VERSION), sizeof(SERIALIZATION_VERSION));
+	key.process_bytes(reinterpret_cast<const void *>(buildId.data()), buildId.size());
+	return key.checksum();
+}
+
 DLL_LINKAGE void preinitDLL(CConsoleHandler * Console, bool onlyEssential)
 {
 	console = Console;
@@ -122,7 +167,11 @@ void LibClasses::init(bool onlyEssential)
 
 	logGlobal->info("\tInitializing handlers: %d ms", totalTime.getDiff());
 
-	modh->load();
+	if(!loadContentCache(getContentCachePath()))
+	{
+		modh->load();
+		saveContentCache(getContentCachePath());
+	}
 
 	modh->afterLoad(onlyEssential);
 
@@ -130,6 +179,109 @@ void LibClasses::init(bool onlyEssential)
 	//TODO: This should be done every time mod config changes
 }
 
+bool LibClasses::loadContentCache(const boost::filesystem::path & path)
+{
+	if(!boost::filesystem::exists(path))
+		return false;
+
+	CStopWatch timer;
+	std::unique_ptr<CLoadFile> file;
+	ui32 key = 0;
+	try
+	{
+		file = make_unique<CLoadFile>(path);
+		file->checkMagicBytes(CONTENT_CACHE_MAGIC);
+		file->serializer & key;
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Content cache is not usable: %s", e.what());
+		return false;
+	}
+
+	if(key != getContentCacheKey(*modh))
+	{
+		logGlobal->info("\tContent cache is outdated");
+		return false;
+	}
+
+	// mod handler is loaded in place and also keeps state from before content loading, keep it to restore on failure
+	CMemorySerializer modhState;
+	modhState.oser & *modh;
+
+	try
+	{
+		serializeContent(file->serializer);
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->error("Failed to load content cache %s: %s", path.string(), e.what());
+		file.reset();
+		boost::system::error_code ec;
+		boost::filesystem::remove(path, ec);
+
+		// handlers are in unknown state, content will be loaded from mods into new ones
+		modhState.iser & *modh;
+		resetContentHandlers();
+		return false;
+	}
+	logGlobal->info("\tLoading content cache: %d ms", timer.getDiff());
+	return true;
+}
+
+void LibClasses::saveContentCache(const boost::filesystem::path & path)
+{
+	// client and server may write cache at the same time, write to separate file and replace old cache only once done
+	const auto tempPath = path.parent_path() / boost::filesystem::unique_path("contentCache-%%%%%%%%.tmp");
+
+	CStopWatch timer;
+	try
+	{
+		{
+			CSaveFile file(tempPath);
+			file.putMagicBytes(CONTENT_CACHE_MAGIC);
+			file.serializer & getContentCacheKey(*modh);
+			serializeContent(file.serializer);
+		}
+		boost::filesystem::rename(tempPath, path);
+		logGlobal->info("\tSaving content cache: %d ms", timer.getDiff());
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to save content cache: %s", e.what());
+		boost::system::error_code ec;
+		boost::filesystem::remove(tempPath, ec);
+	}
+}
+
+void LibClasses::resetContentHandlers()
+{
+	CStopWatch pomtime;
+
+	delete heroh;
+	delete arth;
+	delete creh;
+	delete townh;
+	delete objh;
+	delete objtypeh;
+	delete spellh;
+	delete skillh;
+	delete bth;
+	delete tplh;
+
+	// same order as in init
+	createHandler(bth, "Bonus type", pomtime);
+	createHandler(heroh, "Hero", pomtime);
+	createHandler(arth, "Artifact", pomtime);
+	createHandler(creh, "Creature", pomtime);
+	createHandler(townh, "Town", pomtime);
+	createHandler(objh, "Object", pomtime);
+	createHandler(objtypeh, "Object types information", pomtime);
+	createHandler(spellh, "Spell", pomtime);
+	createHandler(skillh, "Skill", pomtime);
+	createHandler(tplh, "Template", pomtime);
+}
+
 void LibClasses::clear()
 {
 	delete generaltexth;
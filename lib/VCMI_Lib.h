@@ -33,6 +33,22 @@ class DLL_LINKAGE LibClasses
 
 	void callWhenDeserializing(); //should be called only by serialize !!!
 	void makeNull(); //sets all handler pointers to null
+
+	template <typename Handler> void serializeContent(Handler &h)
+	{
+		// handlers are serialized in place since they were already created and may be referenced
+		h & *heroh;
+		h & *arth;
+		h & *creh;
+		h & *townh;
+		h & *objh;
+		h & *objtypeh;
+		h & *spellh;
+		h & *skillh;
+		h & *modh;
+		h & *bth;
+		h & *tplh;
+	}
 public:
 	bool IS_AI_ENABLED; //unused?
 
@@ -56,6 +72,12 @@ public:
 	void init(bool onlyEssential); //uses standard config file
 	void clear(); //deletes all handlers and its data
 
+	/// content cache keeps state of handlers after loading of all mods to skip it if no mods or build have changed
+	/// cache must be loaded into newly created handlers, on failure handlers are replaced with new ones
+	bool loadContentCache(const boost::filesystem::path & path); //returns false if cache is missing, outdated or broken
+	void saveContentCache(const boost::filesystem::path & path);
+	void resetContentHandlers(); //replaces handlers filled by content loading with new ones
+
 
 	void loadFilesystem(bool onlyEssential);// basic initialization. should be called before init()
 
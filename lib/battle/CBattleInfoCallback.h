@@ -131,6 +131,9 @@ public:
 
 	ReachabilityInfo getReachability(const battle::Unit * unit) const;
 	ReachabilityInfo getReachability(const ReachabilityInfo::Parameters & params) const;
+	//same as above, but reuses accessibility of current battle state obtained from getAccesibility(), for repeated queries on unchanged state
+	ReachabilityInfo getReachability(const battle::Unit * unit, const AccessibilityInfo & accessibility) const;
+	ReachabilityInfo getReachability(const ReachabilityInfo::Parameters & params, const AccessibilityInfo & accessibility) const;
 	AccessibilityInfo getAccesibility() const;
 	AccessibilityInfo getAccesibility(const battle::Unit * stack) const; //Hexes ocupied by stack will be marked as accessible.
 	AccessibilityInfo getAccesibility(const std::vector<BattleHex> & accessibleHexes) const; //given hexes will be marked as accessible
@@ -138,7 +141,7 @@ public:
 
 	BattleHex getAvaliableHex(CreatureID creID, ui8 side, int initialPos = -1) const; //find place for adding new stack
 protected:
-	ReachabilityInfo getFlyingReachability(const ReachabilityInfo::Parameters & params) const;
+	ReachabilityInfo getFlyingReachability(const AccessibilityInfo & accessibility, const ReachabilityInfo::Parameters & params) const;
 	ReachabilityInfo makeBFS(const AccessibilityInfo & accessibility, const ReachabilityInfo::Parameters & params) const;
 	std::set<BattleHex> getStoppers(BattlePerspective::BattlePerspective whichSidePerspective) const; //get hexes with stopping obstacles (quicksands)
 };
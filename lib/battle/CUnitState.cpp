@@ -563,7 +563,7 @@ int32_t CUnitState::getCasterUnitId() const
 
 ui8 CUnitState::getSpellSchoolLevel(const spells::Spell * spell, int * outSelectedSchool) const
 {
-	int skill = valOfBonuses(Selector::typeSubtype(Bonus::SPELLCASTER, spell->getIndex()));
+	int skill = valOfBonuses(Bonus::SPELLCASTER, spell->getIndex());
 	vstd::abetween(skill, 0, 3);
 	return skill;
 }
@@ -989,9 +989,9 @@ CUnitStateDetached::CUnitStateDetached(const IUnitInfo * unit_, const IBonusBear
 
 }
 
-const TBonusListPtr CUnitStateDetached::getAllBonuses(const CSelector & selector, const CSelector & limit, const CBonusSystemNode * root, const std::string & cachingStr) const
+const TBonusListPtr CUnitStateDetached::getAllBonuses(const CSelector & selector, const CSelector & limit, const CBonusSystemNode * root, const BonusCacheKey & cachingKey) const
 {
-	return bonus->getAllBonuses(selector, limit, root, cachingStr);
+	return bonus->getAllBonuses(selector, limit, root, cachingKey);
 }
 
 int64_t CUnitStateDetached::getTreeVersion() const
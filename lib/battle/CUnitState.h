@@ -310,7 +310,7 @@ public:
 	explicit CUnitStateDetached(const IUnitInfo * unit_, const IBonusBearer * bonus_);
 
 	const TBonusListPtr getAllBonuses(const CSelector & selector, const CSelector & limit,
-		const CBonusSystemNode * root = nullptr, const std::string & cachingStr = "") const override;
+		const CBonusSystemNode * root = nullptr, const BonusCacheKey & cachingKey = BonusCacheKey()) const override;
 
 	int64_t getTreeVersion() const override;
 
@@ -55,6 +55,7 @@ std::unordered_set<ResourceID> CMappedFileLoader::getFilteredFiles(std::function
 }
 
 CFilesystemList::CFilesystemList()
+	: indexRevision(-1), revision(0)
 {
 	//loaders = new std::vector<std::unique_ptr<ISimpleResourceLoader> >;
 }
@@ -64,25 +65,59 @@ CFilesystemList::~CFilesystemList()
 	//delete loaders;
 }
 
-std::unique_ptr<CInputStream> CFilesystemList::load(const ResourceID & resourceName) const
+const ISimpleResourceLoader * CFilesystemList::findLoader(const ResourceID & resourceName) const
 {
-	// load resource from last loader that have it (last overridden version)
-	for (auto & loader : boost::adaptors::reverse(loaders))
 	{
-		if (loader->existsResource(resourceName))
-			return loader->load(resourceName);
+		boost::shared_lock<boost::shared_mutex> lock(indexMutex);
+		if (indexRevision == getRevision())
+		{
+			auto it = index.find(resourceName);
+			return it != index.end() ? it->second : nullptr;
+		}
 	}
 
+	boost::unique_lock<boost::shared_mutex> lock(indexMutex);
+	if (indexRevision != getRevision())
+		rebuildIndex();
+
+	auto it = index.find(resourceName);
+	return it != index.end() ? it->second : nullptr;
+}
+
+int CFilesystemList::getRevision() const
+{
+	// revisions only grow, so sum changes whenever any of the lists changes
+	int result = revision;
+	for (auto list : nestedLists)
+		result += list->getRevision();
+	return result;
+}
+
+void CFilesystemList::rebuildIndex() const
+{
+	// read revision first - changes made while index is being built will cause another rebuild
+	indexRevision = getRevision();
+	index.clear();
+
+	for (auto & loader : loaders)
+		for (auto & entry : loader->getFilteredFiles([](const ResourceID &){ return true; }))
+			index[entry] = loader.get();
+}
+
+std::unique_ptr<CInputStream> CFilesystemList::load(const ResourceID & resourceName) const
+{
+	// load resource from last loader that have it (last overridden version)
+	auto loader = findLoader(resourceName);
+	if (loader)
+		return loader->load(resourceName);
+
 	throw std::runtime_error("Resource with name " + resourceName.getName() + " and type "
 		+ EResTypeHelper::getEResTypeAsString(resourceName.getType()) + " wasn't found.");
 }
 
 bool CFilesystemList::existsResource(const ResourceID & resourceName) const
 {
-	for (auto & loader : loaders)
-		if (loader->existsResource(resourceName))
-			return true;
-	return false;
+	return findLoader(resourceName) != nullptr;
 }
 
 std::string CFilesystemList::getMountPoint() const
@@ -92,8 +127,9 @@ std::string CFilesystemList::getMountPoint() const
 
 boost::optional<boost::filesystem::path> CFilesystemList::getResourceName(const ResourceID & resourceName) const
 {
-	if (existsResource(resourceName))
-		return getResourcesWithName(resourceName).back()->getResourceName(resourceName);
+	auto loader = findLoader(resourceName);
+	if (loader)
+		return loader->getResourceName(resourceName);
 	return boost::optional<boost::filesystem::path>();
 }
 
@@ -115,6 +151,7 @@ void CFilesystemList::updateFilteredFiles(std::function<bool(const std::string &
 {
 	for (auto & loader : loaders)
 		loader->updateFilteredFiles(filter);
+	revision++;
 }
 
 std::unordered_set<ResourceID> CFilesystemList::getFilteredFiles(std::function<bool(const ResourceID &)> filter) const
@@ -139,6 +176,7 @@ bool CFilesystemList::createResource(std::string filename, bool update)
 			// Check if resource was created successfully. Possible reasons for this to fail
 			// a) loader failed to create resource (e.g. read-only FS)
 			// b) in update mode, call with filename that does not exists
+			revision++;
 			assert(load(ResourceID(filename)));
 
 			logGlobal->trace("Resource created successfully");
@@ -161,7 +199,27 @@ std::vector<const ISimpleResourceLoader *> CFilesystemList::getResourcesWithName
 
 void CFilesystemList::addLoader(ISimpleResourceLoader * loader, bool writeable)
 {
+	boost::unique_lock<boost::shared_mutex> lock(indexMutex);
+	const bool indexValid = indexRevision == getRevision();
+	int expected = indexRevision + 1;
+
 	loaders.push_back(std::unique_ptr<ISimpleResourceLoader>(loader));
 	if (writeable)
 		writeableLoaders.insert(loader);
+
+	if (auto list = dynamic_cast<const CFilesystemList *>(loader))
+	{
+		expected += list->getRevision();
+		nestedLists.push_back(list);
+	}
+	revision++;
+
+	if (indexValid)
+	{
+		// index was up to date - new loader has highest priority, so it provides all of its files
+		// concurrent changes make getRevision() differ from expected value and cause full rebuild
+		for (auto & entry : loader->getFilteredFiles([](const ResourceID &){ return true; }))
+			index[entry] = loader;
+		indexRevision = expected;
+	}
 }
@@ -57,6 +57,22 @@ class DLL_LINKAGE CFilesystemList : public ISimpleResourceLoader
 
 	std::set<ISimpleResourceLoader *> writeableLoaders;
 
+	/// Loader that provides each resource - the last one that has it
+	mutable std::unordered_map<ResourceID, const ISimpleResourceLoader *> index;
+	mutable int indexRevision; //value of getRevision() index was built for
+	mutable boost::shared_mutex indexMutex;
+
+	/// Increased on every change of contents of this list
+	mutable std::atomic<int> revision;
+	/// Lists added as loaders of this one, change in any of them invalidates our index
+	std::vector<const CFilesystemList *> nestedLists;
+
+	/// Revision of this list combined with revisions of all nested lists, changes whenever any of them changes
+	int getRevision() const;
+	/// Returns loader that provides given resource or nullptr if there is none
+	const ISimpleResourceLoader * findLoader(const ResourceID & resourceName) const;
+	void rebuildIndex() const;
+
 	//FIXME: this is only compile fix, should be removed in the end
 	CFilesystemList(CFilesystemList &) = delete;
 	CFilesystemList &operator=(CFilesystemList &) = delete;
@@ -12,9 +12,26 @@
 
 #include "CFileInputStream.h"
 #include "CCompressedStream.h"
+#include "CMemoryStream.h"
 
 #include "CBinaryReader.h"
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+/// Stream over archive entry in mapped archive, keeps mapping alive as long as it is used
+class CMappedEntryStream : public CMemoryStream
+{
+	std::shared_ptr<const boost::interprocess::mapped_region> mapping;
+
+public:
+	CMappedEntryStream(std::shared_ptr<const boost::interprocess::mapped_region> mapping, si64 offset, si64 size)
+		: CMemoryStream(static_cast<const ui8 *>(mapping->get_address()) + offset, size),
+		mapping(std::move(mapping))
+	{
+	}
+};
+
 ArchiveEntry::ArchiveEntry()
 	: offset(0), fullSize(0), compressedSize(0)
 {
@@ -46,6 +63,17 @@ CArchiveLoader::CArchiveLoader(std::string _mountPoint, boost::filesystem::path
 		throw std::runtime_error("LOD archive format unknown. Cannot deal with " + archive.string());
 
 	logGlobal->trace("%sArchive \"%s\" loaded (%d files found).", ext, archive.filename(), entries.size());
+
+	try
+	{
+		boost::interprocess::file_mapping file(archive.string().c_str(), boost::interprocess::read_only);
+		mapping = std::make_shared<const boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+	}
+	catch(const boost::interprocess::interprocess_exception & e)
+	{
+		// not fatal - entries will be read using file streams
+		logGlobal->warn("Failed to map archive %s into memory: %s", archive.string(), e.what());
+	}
 }
 
 void CArchiveLoader::initLODArchive(const std::string &mountPoint, CFileInputStream & fileStream)
@@ -146,16 +174,18 @@ std::unique_ptr<CInputStream> CArchiveLoader::load(const ResourceID & resourceNa
 
 	const ArchiveEntry & entry = entries.at(resourceName);
 
-	if (entry.compressedSize != 0) //compressed data
-	{
-		auto fileStream = make_unique<CFileInputStream>(archive, entry.offset, entry.compressedSize);
+	const si64 storedSize = entry.compressedSize != 0 ? entry.compressedSize : entry.fullSize;
+	std::unique_ptr<CInputStream> stream;
 
-		return make_unique<CCompressedStream>(std::move(fileStream), false, entry.fullSize);
-	}
+	if (mapping && static_cast<ui64>(entry.offset) + storedSize <= mapping->get_size())
+		stream = make_unique<CMappedEntryStream>(mapping, entry.offset, storedSize);
 	else
-	{
-		return make_unique<CFileInputStream>(archive, entry.offset, entry.fullSize);
-	}
+		stream = make_unique<CFileInputStream>(archive, entry.offset, storedSize);
+
+	if (entry.compressedSize != 0) //compressed data
+		return make_unique<CCompressedStream>(std::move(stream), false, entry.fullSize);
+	else
+		return stream;
 }
 
 bool CArchiveLoader::existsResource(const ResourceID & resourceName) const
@@ -14,6 +14,14 @@
 
 class CFileInputStream;
 
+namespace boost
+{
+namespace interprocess
+{
+	class mapped_region;
+}
+}
+
 /**
  * A struct which holds information about the archive entry e.g. where it is located in space of the archive container.
  */
@@ -92,4 +100,7 @@ private:
 
 	/** Holds all entries of the archive file. An entry can be accessed via the entry name. **/
 	std::unordered_map<ResourceID, ArchiveEntry> entries;
+
+	/** Whole archive mapped into memory, entries are read directly from it. Empty if mapping failed. **/
+	std::shared_ptr<const boost::interprocess::mapped_region> mapping;
 };
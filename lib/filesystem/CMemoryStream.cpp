@@ -20,7 +20,7 @@ si64 CMemoryStream::read(ui8 * data, si64 size)
 {
 	si64 toRead = std::min(this->size - tell(), size);
 	std::copy(this->data + position, this->data + position + toRead, data);
-	position += size;
+	position += toRead;
 	return toRead;
 }
 
@@ -19,7 +19,7 @@ CBasicLogConfigurator::CBasicLogConfigurator(boost::filesystem::path filePath, C
 void CBasicLogConfigurator::configureDefault()
 {
 	CLogger::getGlobalLogger()->addTarget(make_unique<CLogConsoleTarget>(console));
-	CLogger::getGlobalLogger()->addTarget(make_unique<CLogFileTarget>(filePath, appendToLogFile));
+	CLogger::getGlobalLogger()->addTarget(make_unique<CLogAsyncTarget>(make_unique<CLogFileTarget>(filePath, appendToLogFile)));
 	appendToLogFile = true;
 }
 
@@ -85,7 +85,7 @@ void CBasicLogConfigurator::configure()
 			const JsonNode & fileFormatNode = fileNode["format"];
 			if(!fileFormatNode.isNull()) fileTarget->setFormatter(CLogFormatter(fileFormatNode.String()));
 		}
-		CLogger::getGlobalLogger()->addTarget(std::move(fileTarget));
+		CLogger::getGlobalLogger()->addTarget(make_unique<CLogAsyncTarget>(std::move(fileTarget)));
 		appendToLogFile = true;
 	}
 	catch(const std::exception & e)
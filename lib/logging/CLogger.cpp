@@ -128,6 +128,7 @@ CLogger::CLogger(const CLoggerDomain & domain) : domain(domain)
 		level = ELogLevel::NOT_SET;
 		parent = getLogger(domain.getParent());
 	}
+	updateEffectiveLevel();
 }
 
 void CLogger::log(ELogLevel::ELogLevel level, const std::string & message) const
@@ -138,6 +139,9 @@ void CLogger::log(ELogLevel::ELogLevel level, const std::string & message) const
 
 void CLogger::log(ELogLevel::ELogLevel level, const boost::format & fmt) const
 {
+	if(getEffectiveLevel() > level)
+		return;
+
 	try
 	{
 		log(level, fmt.str());
@@ -156,9 +160,14 @@ ELogLevel::ELogLevel CLogger::getLevel() const
 
 void CLogger::setLevel(ELogLevel::ELogLevel level)
 {
-	TLockGuard _(mx);
-	if (!domain.isGlobalDomain() || level != ELogLevel::NOT_SET)
-		this->level = level;
+	{
+		TLockGuard _(mx);
+		if (!domain.isGlobalDomain() || level != ELogLevel::NOT_SET)
+			this->level = level;
+	}
+	// loggers of sub-domains may inherit level from this one
+	updateEffectiveLevel();
+	CLogManager::get().updateEffectiveLevels();
 }
 
 const CLoggerDomain & CLogger::getDomain() const { return domain; }
@@ -170,13 +179,22 @@ void CLogger::addTarget(std::unique_ptr<ILogTarget> && target)
 }
 
 ELogLevel::ELogLevel CLogger::getEffectiveLevel() const
+{
+	return effectiveLevel.load(std::memory_order_relaxed);
+}
+
+void CLogger::updateEffectiveLevel()
 {
 	for(const CLogger * logger = this; logger != nullptr; logger = logger->parent)
+	{
 		if(logger->getLevel() != ELogLevel::NOT_SET)
-			return logger->getLevel();
-
+		{
+			effectiveLevel = logger->getLevel();
+			return;
+		}
+	}
 	// This shouldn't be reached, as the root logger must have set a log level
-	return ELogLevel::INFO;
+	effectiveLevel = ELogLevel::INFO;
 }
 
 void CLogger::callTargets(const LogRecord & record) const
@@ -226,8 +244,16 @@ CLogger * CLogManager::getLogger(const CLoggerDomain & domain)
 		return nullptr;
 }
 
+void CLogManager::updateEffectiveLevels()
+{
+	TLockGuard _(mx);
+	for(auto & logger : loggers)
+		logger.second->updateEffectiveLevel();
+}
+
 std::vector<std::string> CLogManager::getRegisteredDomains() const
 {
+	TLockGuard _(mx);
 	std::vector<std::string> domains;
 	for (auto& pair : loggers)
 	{
@@ -413,3 +439,63 @@ void CLogFileTarget::write(const LogRecord & record)
 
 const CLogFormatter & CLogFileTarget::getFormatter() const { return formatter; }
 void CLogFileTarget::setFormatter(const CLogFormatter & formatter) { this->formatter = formatter; }
+
+CLogAsyncTarget::CLogAsyncTarget(std::unique_ptr<ILogTarget> && target, size_t capacity)
+	: target(std::move(target)),
+	capacity(capacity),
+	writing(false),
+	stopping(false)
+{
+	writer = boost::thread(&CLogAsyncTarget::writerLoop, this);
+}
+
+CLogAsyncTarget::~CLogAsyncTarget()
+{
+	{
+		boost::unique_lock<boost::mutex> lock(mx);
+		stopping = true;
+	}
+	recordAdded.notify_one();
+	writer.join();
+}
+
+void CLogAsyncTarget::write(const LogRecord & record)
+{
+	boost::unique_lock<boost::mutex> lock(mx);
+	recordWritten.wait(lock, [this](){ return records.size() < capacity; });
+
+	records.push_back(record);
+	recordAdded.notify_one();
+
+	if(record.level >= ELogLevel::ERROR)
+		recordWritten.wait(lock, [this](){ return records.empty() && !writing; });
+}
+
+void CLogAsyncTarget::writerLoop()
+{
+	boost::unique_lock<boost::mutex> lock(mx);
+	while(true)
+	{
+		recordAdded.wait(lock, [this](){ return stopping || !records.empty(); });
+		if(records.empty())
+			return; // stop requested and all records are written
+
+		LogRecord record = std::move(records.front());
+		records.pop_front();
+		writing = true;
+
+		lock.unlock();
+		try
+		{
+			target->write(record);
+		}
+		catch(...)
+		{
+			// nowhere to report it, drop the record
+		}
+		lock.lock();
+
+		writing = false;
+		recordWritten.notify_all();
+	}
+}
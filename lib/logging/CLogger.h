@@ -67,14 +67,20 @@ public:
 	bool isDebugEnabled() const override;
 	bool isTraceEnabled() const override;
 
+	/// Lock-free, level is cached and updated whenever level of any logger changes
+	ELogLevel::ELogLevel getEffectiveLevel() const override;
+
 private:
+	friend class CLogManager;
+
 	explicit CLogger(const CLoggerDomain & domain);
-	inline ELogLevel::ELogLevel getEffectiveLevel() const; /// Returns the log level applied on this logger whether directly or indirectly.
+	void updateEffectiveLevel();
 	inline void callTargets(const LogRecord & record) const;
 
 	CLoggerDomain domain;
 	CLogger * parent;
 	ELogLevel::ELogLevel level;
+	std::atomic<ELogLevel::ELogLevel> effectiveLevel;
 	std::vector<std::unique_ptr<ILogTarget> > targets;
 	mutable boost::mutex mx;
 	static boost::recursive_mutex smx;
@@ -93,6 +99,7 @@ public:
 	void addLogger(CLogger * logger);
 	CLogger * getLogger(const CLoggerDomain & domain); /// Returns a logger or nullptr if no one is registered for the given domain.
 	std::vector<std::string> getRegisteredDomains() const;
+	void updateEffectiveLevels(); /// Recalculates effective levels of all loggers, e.g. after level of parent domain was changed
 
 private:
 	CLogManager();
@@ -224,3 +231,29 @@ private:
 	CLogFormatter formatter;
 	mutable boost::mutex mx;
 };
+
+/// This target passes log records to another target from a background thread, so logging threads don't wait for I/O.
+/// Up to capacity records are buffered, if writer thread falls behind logging threads are blocked until there is space.
+/// Records of ERROR level are written before write returns, so they are not lost if the application crashes.
+class DLL_LINKAGE CLogAsyncTarget : public ILogTarget
+{
+public:
+	explicit CLogAsyncTarget(std::unique_ptr<ILogTarget> && target, size_t capacity = 4096);
+	/// Writes all remaining records before returning
+	~CLogAsyncTarget();
+
+	void write(const LogRecord & record) override;
+
+private:
+	void writerLoop();
+
+	std::unique_ptr<ILogTarget> target;
+	std::deque<LogRecord> records;
+	size_t capacity;
+	bool writing; //writer thread is passing record to target
+	bool stopping;
+	boost::mutex mx;
+	boost::condition_variable recordAdded;
+	boost::condition_variable recordWritten;
+	boost::thread writer;
+};
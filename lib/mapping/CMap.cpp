@@ -232,8 +232,7 @@ CMapHeader::~CMapHeader()
 }
 
 CMap::CMap()
-	: checksum(0), grailPos(-1, -1, -1), grailRadius(0), terrain(nullptr),
-	guardingCreaturePositions(nullptr)
+	: checksum(0), grailPos(-1, -1, -1), grailRadius(0)
 {
 	allHeroes.resize(allowedHeroes.size());
 	allowedAbilities = VLC->skillh->getDefaultAllowed();
@@ -243,22 +242,6 @@ CMap::CMap()
 
 CMap::~CMap()
 {
-	if(terrain)
-	{
-		for (int i=0; i<width; i++)
-		{
-			for(int j=0; j<height; j++)
-			{
-				delete [] terrain[i][j];
-				delete [] guardingCreaturePositions[i][j];
-			}
-			delete [] terrain[i];
-			delete [] guardingCreaturePositions[i];
-		}
-		delete [] terrain;
-		delete [] guardingCreaturePositions;
-	}
-
 	for(auto obj : objects)
 		obj.dellNull();
 
@@ -279,7 +262,7 @@ void CMap::removeBlockVisTiles(CGObjectInstance * obj, bool total)
 			int zVal = obj->pos.z;
 			if(xVal>=0 && xVal<width && yVal>=0 && yVal<height)
 			{
-				TerrainTile & curt = terrain[xVal][yVal][zVal];
+				TerrainTile & curt = getTile(int3(xVal, yVal, zVal));
 				if(total || obj->visitableAt(xVal, yVal))
 				{
 					curt.visitableObjects -= obj;
@@ -306,7 +289,7 @@ void CMap::addBlockVisTiles(CGObjectInstance * obj)
 			int zVal = obj->pos.z;
 			if(xVal>=0 && xVal<width && yVal>=0 && yVal<height)
 			{
-				TerrainTile & curt = terrain[xVal][yVal][zVal];
+				TerrainTile & curt = getTile(int3(xVal, yVal, zVal));
 				if( obj->visitableAt(xVal, yVal))
 				{
 					curt.visitableObjects.push_back(obj);
@@ -325,16 +308,22 @@ void CMap::addBlockVisTiles(CGObjectInstance * obj)
 void CMap::calculateGuardingGreaturePositions()
 {
 	int levels = twoLevel ? 2 : 1;
-	for (int i=0; i<width; i++)
+	for (int k = 0; k < levels; k++)
 	{
 		for(int j=0; j<height; j++)
 		{
-			for (int k = 0; k < levels; k++)
-				guardingCreaturePositions[i][j][k] = guardingCreaturePosition(int3(i,j,k));
+			for (int i=0; i<width; i++)
+				guardingCreaturePositions[getTileIndex(int3(i,j,k))] = guardingCreaturePosition(int3(i,j,k));
 		}
 	}
 }
 
+const int3 & CMap::getGuardingCreaturePosition(const int3 & pos) const
+{
+	assert(isInTheMap(pos));
+	return guardingCreaturePositions[getTileIndex(pos)];
+}
+
 CGHeroInstance * CMap::getHero(int heroID)
 {
 	for(auto & elem : heroesOnMap)
@@ -388,13 +377,13 @@ bool CMap::isInTheMap(const int3 & pos) const
 TerrainTile & CMap::getTile(const int3 & tile)
 {
 	assert(isInTheMap(tile));
-	return terrain[tile.x][tile.y][tile.z];
+	return terrain[getTileIndex(tile)];
 }
 
 const TerrainTile & CMap::getTile(const int3 & tile) const
 {
 	assert(isInTheMap(tile));
-	return terrain[tile.x][tile.y][tile.z];
+	return terrain[getTileIndex(tile)];
 }
 
 bool CMap::isWaterTile(const int3 &pos) const
@@ -625,18 +614,10 @@ void CMap::addNewObject(CGObjectInstance * obj)
 void CMap::initTerrain()
 {
 	int level = twoLevel ? 2 : 1;
-	terrain = new TerrainTile**[width];
-	guardingCreaturePositions = new int3**[width];
-	for (int i = 0; i < width; ++i)
-	{
-		terrain[i] = new TerrainTile*[height];
-		guardingCreaturePositions[i] = new int3*[height];
-		for (int j = 0; j < height; ++j)
-		{
-			terrain[i][j] = new TerrainTile[level];
-			guardingCreaturePositions[i][j] = new int3[level];
-		}
-	}
+	terrain.clear();
+	terrain.resize(width * height * level);
+	guardingCreaturePositions.clear();
+	guardingCreaturePositions.resize(width * height * level);
 }
 
 CMapEditManager * CMap::getEditManager()
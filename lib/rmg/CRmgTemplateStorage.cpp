@@ -30,6 +30,8 @@ void CRmgTemplateStorage::loadObject(std::string scope, std::string name, const
 
 void CRmgTemplateStorage::loadObject(std::string scope, std::string name, const JsonNode & data)
 {
+	sources.push_back(TemplateSource{scope, name, data});
+
 	auto tpl = new CRmgTemplate();
 	try
 	{
@@ -51,8 +53,15 @@ CRmgTemplateStorage::CRmgTemplateStorage()
 }
 
 CRmgTemplateStorage::~CRmgTemplateStorage()
+{
+	clear();
+}
+
+void CRmgTemplateStorage::clear()
 {
 	for (auto & pair : templates) delete pair.second;
+	templates.clear();
+	sources.clear();
 }
 
 std::vector<bool> CRmgTemplateStorage::getDefaultAllowed() const
@@ -11,8 +11,8 @@
 #pragma once
 
 #include "../IHandlerBase.h"
+#include "../JsonNode.h"
 
-class JsonNode;
 class CRmgTemplate;
 
 /// The CJsonRmgTemplateLoader loads templates from a JSON file.
@@ -31,7 +31,38 @@ public:
 	virtual void loadObject(std::string scope, std::string name, const JsonNode & data) override;
 	virtual void loadObject(std::string scope, std::string name, const JsonNode & data, size_t index) override;
 
+	template <typename Handler> void serialize(Handler & h, const int version)
+	{
+		h & sources;
+		if(!h.saving)
+		{
+			// templates are not serializable, recreate them from source data
+			auto loadedSources = std::move(sources);
+			clear();
+			for(auto & source : loadedSources)
+				loadObject(source.scope, source.name, source.data);
+		}
+	}
+
 private:
+	struct TemplateSource
+	{
+		std::string scope;
+		std::string name;
+		JsonNode data;
+
+		template <typename Handler> void serialize(Handler & h, const int version)
+		{
+			h & scope;
+			h & name;
+			h & data;
+		}
+	};
+
 	std::map<std::string, CRmgTemplate *> templates;
+	/// data from which templates were loaded
+	std::vector<TemplateSource> sources;
+
+	void clear();
 };
 
@@ -19,12 +19,14 @@ CTypeList typeList;
 CTypeList::CTypeList()
 {
 	registerTypes(*this);
+	buildCastChains();
 }
 
 CTypeList::TypeInfoPtr CTypeList::registerType(const std::type_info *type)
 {
-	if(auto typeDescr = getTypeDescriptor(type, false))
-		return typeDescr;  //type found, return ptr to structure
+	auto i = typeInfos.find(type);
+	if(i != typeInfos.end())
+		return i->second;  //type found, return ptr to structure
 
 	//type not found - add it to the list and return given ID
 	auto newType = std::make_shared<TypeDescriptor>();
@@ -37,7 +39,7 @@ CTypeList::TypeInfoPtr CTypeList::registerType(const std::type_info *type)
 
 ui16 CTypeList::getTypeID(const std::type_info *type, bool throws) const
 {
-	auto descriptor = getTypeDescriptor(type, throws);
+	auto descriptor = getTypeDescriptor(*getTables(), type, throws);
 	if (descriptor == nullptr)
 	{
 		return 0;
@@ -45,74 +47,92 @@ ui16 CTypeList::getTypeID(const std::type_info *type, bool throws) const
 	return descriptor->typeID;
 }
 
-std::vector<CTypeList::TypeInfoPtr> CTypeList::castSequence(TypeInfoPtr from, TypeInfoPtr to) const
+void CTypeList::buildCastChains()
 {
-	if(!strcmp(from->name, to->name))
-		return std::vector<CTypeList::TypeInfoPtr>();
+	auto snapshot = std::make_shared<CastTables>();
+	snapshot->typeInfos = typeInfos;
+	snapshot->stride = typeInfos.size() + 1;
+
+	const size_t stride = snapshot->stride;
+	auto & castChains = snapshot->castChains;
+	auto & castTable = snapshot->castTable;
 
-	// Perform a simple BFS in the class hierarchy.
+	castChains.assign(1, TCastChain());
+	castTable.assign(stride * stride, 0);
 
-	auto BFS = [&](bool upcast)
+	for(auto & typeInfo : typeInfos)
 	{
-		std::map<TypeInfoPtr, TypeInfoPtr> previous;
-		std::queue<TypeInfoPtr> q;
-		q.push(to);
-		while(q.size())
+		auto to = typeInfo.second;
+
+		// Perform a simple BFS in the class hierarchy, looking first up and then down.
+		// Every type reached by it can be cast to "to" by following the found path.
+		for(bool upcast : {true, false})
 		{
-			auto typeNode = q.front();
-			q.pop();
-			for(auto & weakNode : (upcast ? typeNode->parents : typeNode->children) )
+			std::map<TypeInfoPtr, TypeInfoPtr> previous;
+			std::queue<TypeInfoPtr> q;
+			q.push(to);
+			while(q.size())
 			{
-				auto nodeBase = weakNode.lock();
-				if(!previous.count(nodeBase))
+				auto typeNode = q.front();
+				q.pop();
+				for(auto & weakNode : (upcast ? typeNode->parents : typeNode->children) )
 				{
-					previous[nodeBase] = typeNode;
-					q.push(nodeBase);
+					auto nodeBase = weakNode.lock();
+					if(!previous.count(nodeBase))
+					{
+						previous[nodeBase] = typeNode;
+						q.push(nodeBase);
+					}
 				}
 			}
-		}
 
-		std::vector<TypeInfoPtr> ret;
-
-		if(!previous.count(from))
-			return ret;
-
-		ret.push_back(from);
-		TypeInfoPtr ptr = from;
-		do
-		{
-			ptr = previous.at(ptr);
-			ret.push_back(ptr);
-		} while(ptr != to);
+			for(auto & link : previous)
+			{
+				auto from = link.first;
+				auto & chainIndex = castTable[from->typeID * stride + to->typeID];
+				if(from == to || chainIndex != 0)
+					continue;
 
-		return ret;
-	};
+				TCastChain chain;
+				for(auto ptr = from; ptr != to; ptr = previous.at(ptr))
+					chain.push_back(casters.at(std::make_pair(ptr, previous.at(ptr))).get());
 
-	// Try looking both up and down.
-	auto ret = BFS(true);
-	if(ret.empty())
-		ret = BFS(false);
+				chainIndex = castChains.size();
+				castChains.push_back(std::move(chain));
+			}
+		}
+	}
 
-	if(ret.empty())
-		THROW_FORMAT("Cannot find relation between types %s and %s. Were they (and all classes between them) properly registered?", from->name % to->name);
+	std::atomic_store(&tables, TCastTablesPtr(std::move(snapshot)));
+}
 
-	return ret;
+CTypeList::TCastTablesPtr CTypeList::getTables() const
+{
+	return std::atomic_load(&tables);
 }
 
-std::vector<CTypeList::TypeInfoPtr> CTypeList::castSequence(const std::type_info *from, const std::type_info *to) const
+const CTypeList::TCastChain & CTypeList::castSequence(const CastTables & snapshot, const std::type_info *from, const std::type_info *to) const
 {
 	//This additional if is needed because getTypeDescriptor might fail if type is not registered
 	// (and if casting is not needed, then registereing should no  be required)
 	if(!strcmp(from->name(), to->name()))
-		return std::vector<CTypeList::TypeInfoPtr>();
+		return snapshot.castChains.front();
+
+	auto fromDescriptor = getTypeDescriptor(snapshot, from);
+	auto toDescriptor = getTypeDescriptor(snapshot, to);
 
-	return castSequence(getTypeDescriptor(from), getTypeDescriptor(to));
+	const ui32 chainIndex = snapshot.castTable.at(fromDescriptor->typeID * snapshot.stride + toDescriptor->typeID);
+
+	if(chainIndex == 0)
+		THROW_FORMAT("Cannot find relation between types %s and %s. Were they (and all classes between them) properly registered?", fromDescriptor->name % toDescriptor->name);
+
+	return snapshot.castChains[chainIndex];
 }
 
-CTypeList::TypeInfoPtr CTypeList::getTypeDescriptor(const std::type_info *type, bool throws) const
+CTypeList::TypeInfoPtr CTypeList::getTypeDescriptor(const CastTables & snapshot, const std::type_info *type, bool throws)
 {
-	auto i = typeInfos.find(type);
-	if(i != typeInfos.end())
+	auto i = snapshot.typeInfos.find(type);
+	if(i != snapshot.typeInfos.end())
 		return i->second; //type found, return ptr to structure
 
 	if(!throws)
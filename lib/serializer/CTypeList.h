@@ -71,38 +71,46 @@ class DLL_LINKAGE CTypeList: public boost::noncopyable
 		const char *name;
 		std::vector<WeakTypeInfoPtr> children, parents;
 	};
-	typedef boost::shared_mutex TMutex;
+	typedef std::vector<const IPointerCaster *> TCastChain;
+	typedef boost::mutex TMutex;
 	typedef boost::unique_lock<TMutex> TUniqueLock;
-	typedef boost::shared_lock<TMutex> TSharedLock;
+
+	/// Immutable snapshot of registered types used for lookups and casting without locking
+	struct CastTables
+	{
+		std::map<const std::type_info *, TypeInfoPtr, TypeComparer> typeInfos; //id and name of descriptor never change after registration
+		std::vector<TCastChain> castChains; //all cast chains between related types, first entry is a placeholder for unrelated types
+		std::vector<ui32> castTable; //flat [from typeID][to typeID] table of indices into castChains, 0 if there is no relation
+		size_t stride;
+	};
+	typedef std::shared_ptr<const CastTables> TCastTablesPtr;
 private:
-	mutable TMutex mx;
+	mutable TMutex mx; //guards registration only, readers use published tables
 
 	std::map<const std::type_info *, TypeInfoPtr, TypeComparer> typeInfos;
 	std::map<std::pair<TypeInfoPtr, TypeInfoPtr>, std::unique_ptr<const IPointerCaster>> casters; //for each pair <Base, Der> we provide a caster (each registered relations creates a single entry here)
 
-	/// Returns sequence of types starting from "from" and ending on "to". Every next type is derived from the previous.
+	/// Replaced as a whole when a relation is registered after construction, so threads that are casting keep their snapshot.
+	/// Accessed only through std::atomic_load/std::atomic_store.
+	TCastTablesPtr tables;
+
+	/// Finds shortest cast chains between all pairs of related types and publishes new tables. Requires mx.
+	/// Called once all types are registered and again if a new relation is registered later.
+	void buildCastChains();
+
+	TCastTablesPtr getTables() const;
+
+	/// Returns sequence of casters that converts "from" into "to", empty if types are same.
 	/// Throws if there is no link registered.
-	std::vector<TypeInfoPtr> castSequence(TypeInfoPtr from, TypeInfoPtr to) const;
-	std::vector<TypeInfoPtr> castSequence(const std::type_info *from, const std::type_info *to) const;
+	const TCastChain & castSequence(const CastTables & snapshot, const std::type_info *from, const std::type_info *to) const;
 
 	template<boost::any(IPointerCaster::*CastingFunction)(const boost::any &) const>
 	boost::any castHelper(boost::any inputPtr, const std::type_info *fromArg, const std::type_info *toArg) const
 	{
-		TSharedLock lock(mx);
-		auto typesSequence = castSequence(fromArg, toArg);
-
+		const TCastTablesPtr snapshot = getTables(); //keeps cast chain alive while casting
 		boost::any ptr = inputPtr;
-		for(int i = 0; i < static_cast<int>(typesSequence.size()) - 1; i++)
-		{
-			auto &from = typesSequence[i];
-			auto &to = typesSequence[i + 1];
-			auto castingPair = std::make_pair(from, to);
-			if(!casters.count(castingPair))
-				THROW_FORMAT("Cannot find caster for conversion %s -> %s which is needed to cast %s -> %s", from->name % to->name % fromArg->name() % toArg->name());
-
-			auto &caster = casters.at(castingPair);
-			ptr = (*caster.*CastingFunction)(ptr); //Why does unique_ptr not have operator->* ..?
-		}
+		for(auto caster : castSequence(*snapshot, fromArg, toArg))
+			ptr = (caster->*CastingFunction)(ptr);
 
 		return ptr;
 	}
@@ -113,7 +121,7 @@ private:
 		return *this;
 	}
 
-	TypeInfoPtr getTypeDescriptor(const std::type_info *type, bool throws = true) const; //if not throws, failure returns nullptr
+	static TypeInfoPtr getTypeDescriptor(const CastTables & snapshot, const std::type_info *type, bool throws = true); //if not throws, failure returns nullptr
 	TypeInfoPtr registerType(const std::type_info *type);
 
 public:
@@ -132,11 +140,18 @@ public:
 		auto bti = registerType(bt);
 		auto dti = registerType(dt); //obtain our TypeDescriptor
 
+		// appliers register the same relations again, existing casters must stay intact
+		if(casters.count(std::make_pair(bti, dti)))
+			return;
+
 		// register the relation between classes
 		bti->children.push_back(dti);
 		dti->parents.push_back(bti);
 		casters[std::make_pair(bti, dti)] = make_unique<const PointerCaster<Base, Derived>>();
 		casters[std::make_pair(dti, bti)] = make_unique<const PointerCaster<Derived, Base>>();
+
+		if(getTables())
+			buildCastChains();
 	}
 
 	ui16 getTypeID(const std::type_info *type, bool throws = false) const;
@@ -29,6 +29,9 @@ using namespace boost::asio::ip;
 #define LIL_ENDIAN
 #endif
 
+static const size_t READ_BUFFER_SIZE = 64 * 1024;
+static const size_t WRITE_BUFFER_FLUSH_SIZE = 1024 * 1024; //flush packs larger than this in parts
+
 
 void CConnection::init()
 {
@@ -40,6 +43,9 @@ void CConnection::init()
 
 	enableSmartPointerSerialization();
 	disableStackSendingByID();
+	readBuffer.resize(READ_BUFFER_SIZE);
+	readBufferPos = readBufferEnd = 0;
+	capturingWrites = false;
 	registerTypes(iser);
 	registerTypes(oser);
 #ifdef LIL_ENDIAN
@@ -51,6 +57,7 @@ void CConnection::init()
 	std::string pom;
 	//we got connection
 	oser & std::string("Aiya!\n") & name & uuid & myEndianess; //identify ourselves
+	flushWrite();
 	iser & pom & pom & contactUuid & contactEndianess;
 	logNetwork->info("Established connection with %s. UUID: %s", pom, contactUuid);
 	mutexRead = std::make_shared<boost::mutex>();
@@ -151,16 +158,29 @@ CConnection::CConnection(std::shared_ptr<TAcceptor> acceptor, std::shared_ptr<bo
 }
 int CConnection::write(const void * data, unsigned size)
 {
+	auto bytes = static_cast<const ui8 *>(data);
+	writeBuffer.insert(writeBuffer.end(), bytes, bytes + size);
+
+	if(!capturingWrites && writeBuffer.size() >= WRITE_BUFFER_FLUSH_SIZE)
+		flushWrite();
+
+	return size;
+}
+void CConnection::flushWrite()
+{
+	if(writeBuffer.empty())
+		return;
+
 	try
 	{
-		int ret;
-		ret = asio::write(*socket,asio::const_buffers_1(asio::const_buffer(data,size)));
-		return ret;
+		asio::write(*socket,asio::buffer(writeBuffer));
+		writeBuffer.clear();
 	}
 	catch(...)
 	{
 		//connection has been lost
 		connected = false;
+		writeBuffer.clear();
 		throw;
 	}
 }
@@ -168,8 +188,31 @@ int CConnection::read(void * data, unsigned size)
 {
 	try
 	{
-		int ret = asio::read(*socket,asio::mutable_buffers_1(asio::mutable_buffer(data,size)));
-		return ret;
+		auto bytes = static_cast<ui8 *>(data);
+		unsigned done = 0;
+
+		while(done < size)
+		{
+			if(readBufferPos == readBufferEnd)
+			{
+				//big chunks are read directly, there is nothing to gain from copying them
+				if(size - done >= readBuffer.size())
+				{
+					asio::read(*socket,asio::mutable_buffers_1(asio::mutable_buffer(bytes + done, size - done)));
+					return size;
+				}
+
+				//take whatever has arrived, read_some blocks only until there is at least one byte
+				readBufferPos = 0;
+				readBufferEnd = socket->read_some(asio::buffer(readBuffer));
+			}
+
+			size_t chunk = std::min<size_t>(size - done, readBufferEnd - readBufferPos);
+			std::copy_n(readBuffer.data() + readBufferPos, chunk, bytes + done);
+			readBufferPos += chunk;
+			done += chunk;
+		}
+		return size;
 	}
 	catch(...)
 	{
@@ -240,7 +283,71 @@ void CConnection::sendPack(const CPack * pack)
 {
 	boost::unique_lock<boost::mutex> lock(*mutexWrite);
 	logNetwork->trace("Sending a pack of type %s", typeid(*pack).name());
-	oser & pack;
+	writePack(pack);
+	flushWrite();
+}
+
+void CConnection::writePack(const CPack * pack)
+{
+	try
+	{
+		oser & pack;
+	}
+	catch(...)
+	{
+		//partially written pack would be sent as start of the next one
+		writeBuffer.clear();
+		throw;
+	}
+}
+
+std::shared_ptr<const std::vector<ui8>> CConnection::serializePack(const CPack * pack)
+{
+	boost::unique_lock<boost::mutex> lock(*mutexWrite);
+	logNetwork->trace("Serializing a pack of type %s", typeid(*pack).name());
+	capturingWrites = true;
+	try
+	{
+		writePack(pack);
+	}
+	catch(...)
+	{
+		capturingWrites = false;
+		throw;
+	}
+	capturingWrites = false;
+
+	auto ret = std::make_shared<std::vector<ui8>>();
+	ret->swap(writeBuffer);
+	return ret;
+}
+
+void CConnection::sendSerializedPack(std::shared_ptr<const std::vector<ui8>> data)
+{
+	boost::unique_lock<boost::mutex> lock(*mutexWrite);
+	try
+	{
+		asio::write(*socket,asio::buffer(*data));
+	}
+	catch(...)
+	{
+		//connection has been lost
+		connected = false;
+		throw;
+	}
+}
+
+bool CConnection::canShareSerialization() const
+{
+	//with smart pointers enabled, output depends on what was sent over this connection earlier
+	return !oser.smartPointerSerialization;
+}
+
+bool CConnection::sharesSerializationWith(const CConnection & other) const
+{
+	return canShareSerialization() && other.canShareSerialization()
+		&& sendStackInstanceByIds == other.sendStackInstanceByIds
+		&& smartVectorMembersSerialization == other.smartVectorMembersSerialization;
 }
 
 void CConnection::disableStackSendingByID()
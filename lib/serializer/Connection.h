@@ -61,6 +61,13 @@ class DLL_LINKAGE CConnection
 
 	int write(const void * data, unsigned size) override;
 	int read(void * data, unsigned size) override;
+	void flushWrite(); //sends everything accumulated in writeBuffer in a single write
+	void writePack(const CPack * pack); //serializes pack into writeBuffer, on failure drops its partial data, requires mutexWrite
+
+	std::vector<ui8> writeBuffer; //data of the pack being sent, flushed once pack is serialized
+	bool capturingWrites; //if true, writeBuffer is never flushed - used by serializePack
+	std::vector<ui8> readBuffer; //data received from socket ahead of deserialization
+	size_t readBufferPos, readBufferEnd;
 
 	std::shared_ptr<boost::asio::io_service> io_service; //can be empty if connection made from socket
 public:
@@ -92,6 +99,15 @@ public:
 	CPack * retrievePack();
 	void sendPack(const CPack * pack);
 
+	/// Serializes pack the same way sendPack would, without sending it
+	/// Result can be sent with sendSerializedPack to every connection that sharesSerializationWith this one
+	std::shared_ptr<const std::vector<ui8>> serializePack(const CPack * pack);
+	void sendSerializedPack(std::shared_ptr<const std::vector<ui8>> data);
+	/// True if output of serializePack does not depend on what was sent over this connection earlier
+	bool canShareSerialization() const;
+	/// True if packs serialized by this connection are valid for the other one as well
+	bool sharesSerializationWith(const CConnection & other) const;
+
 	void disableStackSendingByID();
 	void enableStackSendingByID();
 	void disableSmartPointerSerialization();
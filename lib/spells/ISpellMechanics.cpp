@@ -301,12 +301,12 @@ void BattleCast::cast(const SpellCastEnvironment * env)
 	//Magic Mirror effect
 	if(tryMagicMirror)
 	{
-		const std::string magicMirrorCacheStr = "type_MAGIC_MIRROR";
+		static const auto magicMirrorCacheKey = BonusCacheKey::type(Bonus::MAGIC_MIRROR);
 		static const auto magicMirrorSelector = Selector::type(Bonus::MAGIC_MIRROR);
 
 		auto rangeGen = env->getRandomGenerator().getInt64Range(0, 99);
 
-		const int mirrorChance = mainTarget->valOfBonuses(magicMirrorSelector, magicMirrorCacheStr);
+		const int mirrorChance = mainTarget->valOfBonuses(magicMirrorSelector, magicMirrorCacheKey);
 
 		if(rangeGen() < mirrorChance)
 		{
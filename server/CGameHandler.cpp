@@ -1867,11 +1867,16 @@ void CGameHandler::newTurn()
 				fw.player = player;
 				// find all hidden tiles
 				const auto & fow = getPlayerTeam(player)->fogOfWarMap;
-				for (size_t i=0; i<fow.size(); i++)
-					for (size_t j=0; j<fow.at(i).size(); j++)
-						for (size_t k=0; k<fow.at(i).at(j).size(); k++)
-							if (!fow.at(i).at(j).at(k))
+				const int3 sizes = fow.getSizes();
+				for (int k=0; k<sizes.z; k++)
+					for (int j=0; j<sizes.y; j++)
+					{
+						if (fow.isRowVisible(int3(0, j, k), sizes.x - 1))
+							continue;
+						for (int i=0; i<sizes.x; i++)
+							if (!fow.isVisible(int3(i,j,k)))
 								fw.tiles.insert(int3(i,j,k));
+					}
 
 				sendAndApply (&fw);
 			}
@@ -2737,12 +2742,27 @@ void CGameHandler::heroExchange(ObjectInstanceID hero1, ObjectInstanceID hero2)
 void CGameHandler::sendToAllClients(CPackForClient * pack)
 {
 	logNetwork->trace("\tSending to all clients: %s", typeid(*pack).name());
+
+	//serialize pack only once and send the same data to every client that uses same serialization settings
+	std::shared_ptr<CConnection> serializer;
+	std::shared_ptr<const std::vector<ui8>> serializedPack;
+
 	for (auto c : lobby->connections)
 	{
 		if(!c->isOpen())
 			continue;
 
-		c->sendPack(pack);
+		//connection with smart pointers enabled would get the pack written into its stream twice
+		if(!serializer && lobby->connections.size() > 1 && c->canShareSerialization())
+		{
+			serializer = c;
+			serializedPack = c->serializePack(pack);
+		}
+
+		if(serializer && c->sharesSerializationWith(*serializer))
+			c->sendSerializedPack(serializedPack);
+		else
+			c->sendPack(pack);
 	}
 }
 
@@ -6519,7 +6539,7 @@ void CGameHandler::handleCheatCode(std::string & cheat, PlayerColor player, cons
 		for (int i = 0; i < gs->map->width; i++)
 			for (int j = 0; j < gs->map->height; j++)
 				for (int k = 0; k < (gs->map->twoLevel ? 2 : 1); k++)
-					if (!fowMap.at(i).at(j).at(k) || !fc.mode)
+					if (!fowMap.isVisible(int3(i, j, k)) || !fc.mode)
 						hlp_tab[lastUnc++] = int3(i, j, k);
 		fc.tiles.insert(hlp_tab, hlp_tab + lastUnc);
 		delete [] hlp_tab;
@@ -0,0 +1,53 @@
+/*
+ * CFilesystemListTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/filesystem/AdapterLoaders.h"
+#include "../lib/JsonNode.h"
+
+static CMappedFileLoader * makeLoader(const std::string & file)
+{
+	JsonNode config(JsonNode::JsonType::DATA_STRUCT);
+	config[file].String() = "TARGET.TXT";
+	return new CMappedFileLoader("", config);
+}
+
+TEST(CFilesystemListTest, loaderAddedToNestedListIsVisible)
+{
+	CFilesystemList outer;
+	auto inner = new CFilesystemList();
+	outer.addLoader(inner, false);
+	outer.addLoader(makeLoader("OUTER.TXT"), false);
+
+	//build index of outer list
+	EXPECT_TRUE(outer.existsResource(ResourceID("OUTER.TXT")));
+	EXPECT_FALSE(outer.existsResource(ResourceID("INNER.TXT")));
+
+	inner->addLoader(makeLoader("INNER.TXT"), false);
+
+	EXPECT_TRUE(inner->existsResource(ResourceID("INNER.TXT")));
+	EXPECT_TRUE(outer.existsResource(ResourceID("INNER.TXT")));
+	EXPECT_TRUE(outer.existsResource(ResourceID("OUTER.TXT")));
+}
+
+TEST(CFilesystemListTest, changeOfOtherListDoesNotAffectList)
+{
+	CFilesystemList first;
+	CFilesystemList second;
+	first.addLoader(makeLoader("FIRST.TXT"), false);
+
+	EXPECT_TRUE(first.existsResource(ResourceID("FIRST.TXT")));
+
+	second.addLoader(makeLoader("SECOND.TXT"), false);
+
+	EXPECT_TRUE(first.existsResource(ResourceID("FIRST.TXT")));
+	EXPECT_FALSE(first.existsResource(ResourceID("SECOND.TXT")));
+	EXPECT_TRUE(second.existsResource(ResourceID("SECOND.TXT")));
+}
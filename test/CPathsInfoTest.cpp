@@ -0,0 +1,67 @@
+/*
+ * CPathsInfoTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/CPathfinder.h"
+
+struct CPathsInfoTest : testing::Test
+{
+	CPathsInfo subject;
+
+	CPathsInfoTest()
+		: subject(int3(3, 2, 2), nullptr)
+	{
+	}
+
+	CGPathNode * visitNode(const int3 & tile, EPathfindingLayer layer)
+	{
+		CGPathNode * node = subject.getNode(tile, layer);
+		node->update(tile, layer, CGPathNode::ACCESSIBLE);
+		node->turns = 1;
+		node->moveRemains = 100;
+		node->cost = 1.5;
+		node->action = CGPathNode::NORMAL;
+		node->locked = true;
+		return node;
+	}
+};
+
+TEST_F(CPathsInfoTest, resetClearsPathfindingResults)
+{
+	CGPathNode * start = visitNode(int3(0, 0, 0), EPathfindingLayer::LAND);
+	CGPathNode * target = visitNode(int3(2, 1, 1), EPathfindingLayer::AIR);
+	target->theNodeBefore = start;
+
+	subject.reset();
+
+	for(CGPathNode * node : {start, target})
+	{
+		EXPECT_FALSE(node->reachable());
+		EXPECT_EQ(node->accessible, CGPathNode::NOT_SET);
+		EXPECT_EQ(node->action, CGPathNode::UNKNOWN);
+		EXPECT_EQ(node->moveRemains, 0);
+		EXPECT_EQ(node->theNodeBefore, nullptr);
+		EXPECT_FALSE(node->locked);
+	}
+
+	CGPath path;
+	EXPECT_FALSE(subject.getPath(path, int3(2, 1, 1)));
+}
+
+TEST_F(CPathsInfoTest, resetKeepsNodeCoordinates)
+{
+	visitNode(int3(1, 1, 0), EPathfindingLayer::SAIL);
+
+	subject.reset();
+
+	const CGPathNode * node = subject.getNode(int3(1, 1, 0), EPathfindingLayer::SAIL);
+	EXPECT_EQ(node->coord, int3(1, 1, 0));
+	EXPECT_EQ(node->layer, EPathfindingLayer::SAIL);
+}
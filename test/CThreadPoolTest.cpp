@@ -0,0 +1,82 @@
+/*
+ * CThreadPoolTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/CThreadHelper.h"
+
+TEST(CThreadPoolTest, runsAllTasks)
+{
+	std::vector<int> results(100, 0);
+	std::vector<Task> tasks;
+
+	for(int i = 0; i < results.size(); i++)
+		tasks.push_back([&results, i](){ results[i] = i * 2; });
+
+	CThreadPool::get().run(tasks);
+
+	for(int i = 0; i < results.size(); i++)
+		EXPECT_EQ(results[i], i * 2);
+}
+
+TEST(CThreadPoolTest, parallelForVisitsEveryIndexOnce)
+{
+	std::vector<std::atomic<int>> visits(1000);
+
+	for(auto & visit : visits)
+		visit = 0;
+
+	CThreadPool::get().parallelFor(0, visits.size(), [&visits](size_t i){ visits[i]++; });
+
+	for(auto & visit : visits)
+		EXPECT_EQ(visit, 1);
+}
+
+TEST(CThreadPoolTest, nestedRunDoesNotDeadlock)
+{
+	std::atomic<int> counter(0);
+
+	CThreadPool::get().parallelFor(0, 16, [&counter](size_t)
+	{
+		CThreadPool::get().parallelFor(0, 16, [&counter](size_t){ counter++; });
+	});
+
+	EXPECT_EQ(counter, 256);
+}
+
+TEST(CThreadPoolTest, rethrowsTaskException)
+{
+	std::vector<Task> tasks;
+	tasks.push_back([](){});
+	tasks.push_back([](){ throw std::runtime_error("task failed"); });
+
+	EXPECT_THROW(CThreadPool::get().run(tasks), std::runtime_error);
+}
+
+TEST(CThreadPoolTest, asyncReturnsResult)
+{
+	auto result = CThreadPool::get().async([](){ return 42; });
+
+	EXPECT_EQ(result.get(), 42);
+}
+
+TEST(CThreadPoolTest, runDoesNotWaitForUnrelatedJobs)
+{
+	std::promise<void> release;
+	auto released = release.get_future().share();
+	auto blocked = CThreadPool::get().async([released](){ released.wait(); });
+
+	std::atomic<int> counter(0);
+	CThreadPool::get().parallelFor(0, 16, [&counter](size_t){ counter++; });
+
+	EXPECT_EQ(counter, 16);
+
+	release.set_value();
+	blocked.get();
+}
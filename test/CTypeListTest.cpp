@@ -0,0 +1,82 @@
+/*
+ * CTypeListTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/serializer/CTypeList.h"
+#include "../lib/mapObjects/CGHeroInstance.h"
+#include "../lib/mapObjects/CGTownInstance.h"
+
+TEST(CTypeListTest, castsAlongHierarchy)
+{
+	CGHeroInstance hero;
+
+	CBonusSystemNode * node = &hero;
+	CGObjectInstance * object = &hero;
+
+	EXPECT_EQ(typeList.castRaw(node, &typeid(CBonusSystemNode), &typeid(CGHeroInstance)), &hero);
+	EXPECT_EQ(typeList.castRaw(&hero, &typeid(CGHeroInstance), &typeid(CBonusSystemNode)), node);
+	EXPECT_EQ(typeList.castRaw(&hero, &typeid(CGHeroInstance), &typeid(CGObjectInstance)), object);
+	EXPECT_EQ(typeList.castToMostDerived(node), &hero);
+	EXPECT_EQ(typeList.castToMostDerived(object), &hero);
+}
+
+TEST(CTypeListTest, castToSameTypeIsNoop)
+{
+	CGHeroInstance hero;
+
+	EXPECT_EQ(typeList.castRaw(&hero, &typeid(CGHeroInstance), &typeid(CGHeroInstance)), &hero);
+}
+
+TEST(CTypeListTest, throwsOnUnrelatedTypes)
+{
+	CGHeroInstance hero;
+
+	EXPECT_ANY_THROW(typeList.castRaw(&hero, &typeid(CGHeroInstance), &typeid(CGTownInstance)));
+}
+
+namespace
+{
+	struct LateBase
+	{
+		virtual ~LateBase() = default;
+	};
+
+	struct LateDerived : LateBase
+	{
+	};
+}
+
+TEST(CTypeListTest, relationRegisteredLaterCanBeCastWhileOtherThreadsCast)
+{
+	CGHeroInstance hero;
+	std::atomic<bool> stop(false);
+	std::atomic<int> failures(0);
+
+	boost::thread caster([&]()
+	{
+		while(!stop)
+		{
+			if(typeList.castRaw(&hero, &typeid(CGHeroInstance), &typeid(CBonusSystemNode)) != static_cast<CBonusSystemNode *>(&hero))
+				failures++;
+		}
+	});
+
+	typeList.registerType<LateBase, LateDerived>();
+
+	stop = true;
+	caster.join();
+
+	LateDerived derived;
+	LateBase * base = &derived;
+
+	EXPECT_EQ(failures, 0);
+	EXPECT_EQ(typeList.castRaw(base, &typeid(LateBase), &typeid(LateDerived)), &derived);
+	EXPECT_NE(typeList.getTypeID<LateDerived>(), 0);
+}
@@ -0,0 +1,125 @@
+/*
+ * FogOfWarMapTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/FogOfWarMap.h"
+
+struct FogOfWarMapTest : testing::Test
+{
+	FogOfWarMap subject;
+
+	void SetUp() override
+	{
+		subject.resize(int3(144, 3, 2));
+	}
+};
+
+TEST_F(FogOfWarMapTest, initiallyHidden)
+{
+	EXPECT_EQ(subject.getSizes(), int3(144, 3, 2));
+	EXPECT_FALSE(subject.isVisible(int3(0, 0, 0)));
+	EXPECT_FALSE(subject.isVisible(int3(143, 2, 1)));
+}
+
+TEST_F(FogOfWarMapTest, setVisibleChangesOnlyOneTile)
+{
+	subject.setVisible(int3(64, 1, 1), true);
+
+	EXPECT_TRUE(subject.isVisible(int3(64, 1, 1)));
+	EXPECT_FALSE(subject.isVisible(int3(63, 1, 1)));
+	EXPECT_FALSE(subject.isVisible(int3(65, 1, 1)));
+	EXPECT_FALSE(subject.isVisible(int3(64, 1, 0)));
+	EXPECT_FALSE(subject.isVisible(int3(64, 0, 1)));
+
+	subject.setVisible(int3(64, 1, 1), false);
+	EXPECT_FALSE(subject.isVisible(int3(64, 1, 1)));
+}
+
+TEST_F(FogOfWarMapTest, rowVisibility)
+{
+	for(int x = 10; x < 140; x++)
+		subject.setVisible(int3(x, 2, 0), true);
+
+	EXPECT_TRUE(subject.isRowVisible(int3(10, 2, 0), 139));
+	EXPECT_TRUE(subject.isRowVisible(int3(63, 2, 0), 64));
+	EXPECT_FALSE(subject.isRowVisible(int3(9, 2, 0), 139));
+	EXPECT_FALSE(subject.isRowVisible(int3(10, 2, 0), 140));
+	EXPECT_FALSE(subject.isRowVisible(int3(10, 1, 0), 139));
+}
+
+TEST_F(FogOfWarMapTest, loadsLegacyFormat)
+{
+	std::vector<std::vector<std::vector<ui8>>> legacy(5, std::vector<std::vector<ui8>>(4, std::vector<ui8>(2, 0)));
+	legacy[3][2][1] = 1;
+
+	subject.loadLegacy(legacy);
+
+	EXPECT_EQ(subject.getSizes(), int3(5, 4, 2));
+	EXPECT_TRUE(subject.isVisible(int3(3, 2, 1)));
+	EXPECT_FALSE(subject.isVisible(int3(3, 2, 0)));
+	EXPECT_FALSE(subject.isVisible(int3(2, 3, 1)));
+}
+
+TEST_F(FogOfWarMapTest, setRowVisibleChangesOnlyRange)
+{
+	subject.setRowVisible(int3(60, 1, 1), 130, true);
+
+	EXPECT_TRUE(subject.isRowVisible(int3(60, 1, 1), 130));
+	EXPECT_FALSE(subject.isVisible(int3(59, 1, 1)));
+	EXPECT_FALSE(subject.isVisible(int3(131, 1, 1)));
+	EXPECT_FALSE(subject.isVisible(int3(64, 0, 1)));
+	EXPECT_FALSE(subject.isVisible(int3(64, 1, 0)));
+
+	subject.setRowVisible(int3(64, 1, 1), 127, false);
+
+	EXPECT_TRUE(subject.isRowVisible(int3(60, 1, 1), 63));
+	EXPECT_FALSE(subject.isVisible(int3(64, 1, 1)));
+	EXPECT_FALSE(subject.isVisible(int3(127, 1, 1)));
+	EXPECT_TRUE(subject.isRowVisible(int3(128, 1, 1), 130));
+}
+
+TEST_F(FogOfWarMapTest, areaMatchesTilesInRange)
+{
+	const int3 sizes(144, 40, 2);
+	const std::vector<int3> centers = {int3(0, 0, 0), int3(70, 20, 1), int3(143, 39, 1), int3(63, 2, 0)};
+	const std::vector<int3::EDistanceFormula> formulas = {int3::DIST_2D, int3::DIST_MANHATTAN, int3::DIST_CHEBYSHEV};
+
+	for(auto formula : formulas)
+	{
+		for(auto & center : centers)
+		{
+			for(int radius : {0, 1, 5, 13})
+			{
+				subject.resize(sizes);
+				subject.revealArea(center, radius, formula);
+
+				int3 tile;
+				for(tile.z = 0; tile.z < sizes.z; tile.z++)
+					for(tile.y = 0; tile.y < sizes.y; tile.y++)
+						for(tile.x = 0; tile.x < sizes.x; tile.x++)
+						{
+							const bool inRange = tile.z == center.z && center.dist(tile, formula) <= static_cast<ui32>(radius);
+							ASSERT_EQ(subject.isVisible(tile), inRange) << center.toString() << " " << radius << " " << tile.toString();
+						}
+
+				subject.setRowVisible(int3(0, center.y, center.z), sizes.x - 1, true);
+				subject.hideArea(center, radius, formula);
+
+				tile.z = center.z;
+				for(tile.y = 0; tile.y < sizes.y; tile.y++)
+					for(tile.x = 0; tile.x < sizes.x; tile.x++)
+					{
+						const bool visible = tile.y == center.y && center.dist(tile, formula) > static_cast<ui32>(radius);
+						ASSERT_EQ(subject.isVisible(tile), visible) << center.toString() << " " << radius << " " << tile.toString();
+					}
+			}
+		}
+	}
+}
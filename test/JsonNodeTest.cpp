@@ -0,0 +1,51 @@
+/*
+ * JsonNodeTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/JsonNode.h"
+
+static JsonNode parse(const std::string & text)
+{
+	return JsonNode(text.data(), text.size());
+}
+
+TEST(JsonNodeTest, parsesNestedData)
+{
+	JsonNode node = parse("{ \"list\" : [ 1, \"two\", { \"three\" : 3 } ], \"value#override\" : true }");
+
+	ASSERT_EQ(node["list"].Vector().size(), 3);
+	EXPECT_EQ(node["list"].Vector()[0].Integer(), 1);
+	EXPECT_EQ(node["list"].Vector()[1].String(), "two");
+	EXPECT_EQ(node["list"].Vector()[2]["three"].Integer(), 3);
+
+	EXPECT_TRUE(node["value"].Bool());
+	EXPECT_EQ(node["value"].flags, std::vector<std::string>{"override"});
+}
+
+TEST(JsonNodeTest, duplicatedKeyKeepsLastValue)
+{
+	JsonNode node = parse("{ \"value\" : 1, \"value\" : 2 }");
+
+	EXPECT_EQ(node.Struct().size(), 1);
+	EXPECT_EQ(node["value"].Integer(), 2);
+}
+
+TEST(JsonNodeTest, moveLeavesSourceEmpty)
+{
+	JsonNode source = parse("{ \"value\" : [ 1, 2, 3 ] }");
+	source.setMeta("mod");
+
+	JsonNode target(std::move(source));
+
+	EXPECT_TRUE(source.isNull());
+	EXPECT_EQ(target["value"].Vector().size(), 3);
+	EXPECT_EQ(target.meta, "mod");
+	EXPECT_EQ(target["value"].Vector()[0].meta, "mod");
+}
@@ -0,0 +1,109 @@
+/*
+ * LibClassesTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/VCMI_Lib.h"
+#include "../lib/CArtHandler.h"
+#include "../lib/CCreatureHandler.h"
+#include "../lib/CHeroHandler.h"
+#include "../lib/CModHandler.h"
+#include "../lib/CTownHandler.h"
+#include "../lib/spells/CSpellHandler.h"
+
+class LibClassesTest : public testing::Test
+{
+public:
+	struct ContentSummary
+	{
+		size_t creatures;
+		size_t artifacts;
+		size_t heroes;
+		size_t factions;
+		size_t spells;
+		std::string firstCreatureName;
+		std::vector<std::string> activeMods;
+
+		ContentSummary()
+			: creatures(VLC->creh->creatures.size()),
+			artifacts(VLC->arth->artifacts.size()),
+			heroes(VLC->heroh->heroes.size()),
+			factions(VLC->townh->factions.size()),
+			spells(VLC->spellh->objects.size()),
+			activeMods(VLC->modh->getActiveMods())
+		{
+			if(creatures > 0)
+				firstCreatureName = VLC->creh->creatures[0]->nameSing;
+		}
+
+		void expectSameAs(const ContentSummary & other) const
+		{
+			EXPECT_EQ(creatures, other.creatures);
+			EXPECT_EQ(artifacts, other.artifacts);
+			EXPECT_EQ(heroes, other.heroes);
+			EXPECT_EQ(factions, other.factions);
+			EXPECT_EQ(spells, other.spells);
+			EXPECT_EQ(firstCreatureName, other.firstCreatureName);
+			EXPECT_EQ(activeMods, other.activeMods);
+		}
+	};
+
+	boost::filesystem::path cachePath;
+
+	LibClassesTest()
+		: cachePath(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("contentCacheTest-%%%%%%%%.vcmi"))
+	{
+	}
+
+	~LibClassesTest()
+	{
+		boost::system::error_code ec;
+		boost::filesystem::remove(cachePath, ec);
+	}
+};
+
+TEST_F(LibClassesTest, contentCacheRoundTrip)
+{
+	const ContentSummary expected;
+
+	VLC->saveContentCache(cachePath);
+	ASSERT_TRUE(boost::filesystem::exists(cachePath));
+
+	VLC->resetContentHandlers();
+	EXPECT_TRUE(VLC->creh->creatures.empty());
+
+	ASSERT_TRUE(VLC->loadContentCache(cachePath));
+
+	ContentSummary().expectSameAs(expected);
+}
+
+TEST_F(LibClassesTest, brokenContentCacheIsRejected)
+{
+	const ContentSummary expected;
+
+	VLC->saveContentCache(cachePath);
+
+	const auto brokenPath = cachePath.string() + ".broken";
+	{
+		std::ifstream source(cachePath.string(), std::ios::binary);
+		std::vector<char> data((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+		std::ofstream broken(brokenPath, std::ios::binary);
+		broken.write(data.data(), data.size() / 2);
+	}
+
+	VLC->resetContentHandlers();
+	EXPECT_FALSE(VLC->loadContentCache(brokenPath));
+	EXPECT_FALSE(boost::filesystem::exists(brokenPath));
+
+	//handlers were replaced with empty ones, valid cache can be loaded into them
+	EXPECT_TRUE(VLC->creh->creatures.empty());
+	ASSERT_TRUE(VLC->loadContentCache(cachePath));
+
+	ContentSummary().expectSameAs(expected);
+}
@@ -0,0 +1,77 @@
+/*
+ * SDL_PixelsTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../../client/gui/SDL_Pixels.h"
+
+class SDL_PixelsTest : public testing::Test
+{
+public:
+	static const int width = 37;
+	static const int height = 23;
+	static const int dstPitch = width * 4 + 12; //rows of destination surface may be padded
+
+	std::vector<SDL_Color> colors;
+	SDL_Palette palette;
+	std::vector<Uint8> source;
+	std::vector<Uint8> background;
+
+	SDL_PixelsTest()
+		: colors(256),
+		source(width * height),
+		background(dstPitch * height)
+	{
+		std::mt19937 rand(42);
+
+		//same layout as in sprites - transparency, shadow and selection colors followed by opaque ones
+		const Uint8 alphas[] = {0, 32, 64, 128, 128, 0, 128, 64};
+		for(size_t i = 0; i < colors.size(); i++)
+		{
+			colors[i].r = rand();
+			colors[i].g = rand();
+			colors[i].b = rand();
+			if(i < ARRAY_COUNT(alphas))
+				colors[i].a = alphas[i];
+			else
+				colors[i].a = i % 5 == 0 ? rand() : 255;
+		}
+
+		palette.ncolors = colors.size();
+		palette.colors = colors.data();
+		palette.version = 0;
+		palette.refcount = 1;
+
+		for(auto & pixel : source)
+			pixel = rand();
+		for(auto & pixel : background)
+			pixel = rand();
+	}
+};
+
+TEST_F(SDL_PixelsTest, blit8bppAlphaTo32bppMatchesColorPutter)
+{
+	std::vector<Uint8> expected = background;
+	std::vector<Uint8> actual = background;
+
+	//generic path, still used for other formats
+	for(int y = 0; y < height; y++)
+	{
+		Uint8 * p = expected.data() + y * dstPitch;
+		for(int x = 0; x < width; x++)
+		{
+			const SDL_Color & tbc = colors[source[y * width + x]];
+			ColorPutter<4, +1>::PutColorAlphaSwitch(p, tbc.r, tbc.g, tbc.b, tbc.a);
+		}
+	}
+
+	CSDL_Ext::blit8bppAlphaTo32bppRows(&palette, source.data(), width, actual.data(), dstPitch, width, height);
+
+	EXPECT_EQ(actual, expected);
+}
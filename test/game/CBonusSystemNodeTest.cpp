@@ -0,0 +1,126 @@
+/*
+ * CBonusSystemNodeTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "../../lib/HeroBonus.h"
+
+class CBonusSystemNodeTest : public ::testing::Test
+{
+public:
+	CBonusSystemNode root;
+	CBonusSystemNode left;
+	CBonusSystemNode right;
+	CBonusSystemNode leftChild;
+
+	void SetUp() override
+	{
+		left.attachTo(&root);
+		right.attachTo(&root);
+		leftChild.attachTo(&left);
+	}
+
+	void TearDown() override
+	{
+		leftChild.detachFromAll();
+		left.detachFromAll();
+		right.detachFromAll();
+	}
+
+	std::shared_ptr<Bonus> makeBonus(si32 value)
+	{
+		return std::make_shared<Bonus>(Bonus::PERMANENT, Bonus::PRIMARY_SKILL, Bonus::OTHER, value, 0, PrimarySkill::ATTACK);
+	}
+};
+
+TEST_F(CBonusSystemNodeTest, changeInvalidatesNodeAndDescendants)
+{
+	auto rootVersion = root.getTreeVersion();
+	auto leftVersion = left.getTreeVersion();
+	auto leftChildVersion = leftChild.getTreeVersion();
+
+	left.addNewBonus(makeBonus(1));
+
+	EXPECT_EQ(root.getTreeVersion(), rootVersion);
+	EXPECT_NE(left.getTreeVersion(), leftVersion);
+	EXPECT_NE(leftChild.getTreeVersion(), leftChildVersion);
+}
+
+TEST_F(CBonusSystemNodeTest, changeDoesNotInvalidateSiblings)
+{
+	auto rightVersion = right.getTreeVersion();
+
+	left.addNewBonus(makeBonus(1));
+	leftChild.addNewBonus(makeBonus(2));
+
+	EXPECT_EQ(right.getTreeVersion(), rightVersion);
+}
+
+TEST_F(CBonusSystemNodeTest, parentChangeIsVisibleInCachedChildren)
+{
+	root.addNewBonus(makeBonus(1));
+
+	EXPECT_EQ(leftChild.valOfBonuses(Bonus::PRIMARY_SKILL, PrimarySkill::ATTACK), 1);
+	EXPECT_EQ(right.valOfBonuses(Bonus::PRIMARY_SKILL, PrimarySkill::ATTACK), 1);
+
+	left.addNewBonus(makeBonus(2));
+
+	EXPECT_EQ(leftChild.valOfBonuses(Bonus::PRIMARY_SKILL, PrimarySkill::ATTACK), 3);
+	EXPECT_EQ(right.valOfBonuses(Bonus::PRIMARY_SKILL, PrimarySkill::ATTACK), 1);
+
+	leftChild.detachFrom(&left);
+
+	EXPECT_EQ(leftChild.valOfBonuses(Bonus::PRIMARY_SKILL, PrimarySkill::ATTACK), 0);
+
+	leftChild.attachTo(&left);
+}
+
+TEST_F(CBonusSystemNodeTest, globalChangeInvalidatesAllNodes)
+{
+	auto leftVersion = left.getTreeVersion();
+	auto rightVersion = right.getTreeVersion();
+
+	CBonusSystemNode::treeHasChanged();
+
+	EXPECT_NE(left.getTreeVersion(), leftVersion);
+	EXPECT_NE(right.getTreeVersion(), rightVersion);
+}
+
+TEST(BonusQueryCache, findsInsertedEntries)
+{
+	BonusQueryCache cache;
+	std::vector<TBonusListPtr> lists;
+
+	for(int subtype = -1; subtype < 100; subtype++)
+	{
+		lists.push_back(std::make_shared<BonusList>());
+		cache.insert(BonusCacheKey::typeSubtype(Bonus::PRIMARY_SKILL, subtype), lists.back());
+	}
+
+	for(int subtype = -1; subtype < 100; subtype++)
+		EXPECT_EQ(cache.find(BonusCacheKey::typeSubtype(Bonus::PRIMARY_SKILL, subtype)), lists.at(subtype + 1));
+
+	EXPECT_EQ(cache.find(BonusCacheKey::type(Bonus::PRIMARY_SKILL)), lists.front());
+	EXPECT_EQ(cache.find(BonusCacheKey::typeSubtypeInfo(Bonus::PRIMARY_SKILL, 0, 1)), nullptr);
+	EXPECT_EQ(cache.find(BonusCacheKey::source(Bonus::ARTIFACT, 0)), nullptr);
+
+	cache.clear();
+
+	EXPECT_EQ(cache.find(BonusCacheKey::type(Bonus::PRIMARY_SKILL)), nullptr);
+}
+
+TEST(BonusCacheKey, uniqueKeysDiffer)
+{
+	auto first = BonusCacheKey::unique();
+	auto second = BonusCacheKey::unique();
+
+	EXPECT_NE(first, second);
+	EXPECT_FALSE(first.empty());
+	EXPECT_TRUE(BonusCacheKey().empty());
+}
@@ -14,6 +14,7 @@
 
 #include "../../lib/VCMIDirs.h"
 #include "../../lib/CGameState.h"
+#include "../../lib/CPathfinder.h"
 #include "../../lib/NetPacks.h"
 #include "../../lib/StartInfo.h"
 
@@ -28,12 +29,14 @@
 #include "../../lib/spells/ISpellMechanics.h"
 #include "../../lib/spells/AbilityCaster.h"
 
+#include "../../AI/VCAI/Pathfinding/AINodeStorage.h"
+
 class CGameStateTest : public ::testing::Test, public SpellCastEnvironment, public MapListener
 {
 public:
-	CGameStateTest()
+	explicit CGameStateTest(const std::string & mapPath = "test/MiniTest/")
 		: gameCallback(new GameCallbackMock(this)),
-		mapService("test/MiniTest/", this),
+		mapService(mapPath, this),
 		map(nullptr)
 	{
 		IObjectInterface::cb = gameCallback.get();
@@ -156,6 +159,54 @@ public:
 		ASSERT_EQ(gameState->curB, battle);
 	}
 
+	/// Checks that single destination search finds path of same cost as full search for every tile of the map
+	/// If several paths have equal cost, searches may choose different ones, so nodes are compared by cost
+	void checkSingleDestinationPaths(const CGHeroInstance * hero)
+	{
+		const int3 sizes = gameState->getMapSize();
+
+		CPathsInfo full(sizes, hero);
+		gameState->calculatePaths(hero, full);
+
+		int3 tile;
+		for(tile.z = 0; tile.z < sizes.z; tile.z++)
+		{
+			for(tile.y = 0; tile.y < sizes.y; tile.y++)
+			{
+				for(tile.x = 0; tile.x < sizes.x; tile.x++)
+				{
+					CPathsInfo single(sizes, hero);
+					gameState->calculatePath(hero, single, tile);
+
+					const CGPathNode * expected = full.getPathInfo(tile);
+					const CGPathNode * actual = single.getPathInfo(tile);
+
+					ASSERT_EQ(actual->reachable(), expected->reachable()) << tile.toString();
+
+					if(!expected->reachable())
+						continue;
+
+					//whole path must consist of nodes reached as cheaply as by full search and lead to the hero
+					int steps = 0;
+					for(const CGPathNode * node = actual; node; node = node->theNodeBefore)
+					{
+						ASSERT_LT(steps++, sizes.x * sizes.y * sizes.z) << "Loop in path to " << tile.toString();
+
+						const CGPathNode * fullNode = full.getNode(node->coord, node->layer);
+
+						ASSERT_TRUE(fullNode->reachable()) << tile.toString() << " via " << node->coord.toString();
+						EXPECT_EQ(node->turns, fullNode->turns) << tile.toString() << " via " << node->coord.toString();
+						EXPECT_EQ(node->moveRemains, fullNode->moveRemains) << tile.toString() << " via " << node->coord.toString();
+						EXPECT_FLOAT_EQ(node->cost, fullNode->cost) << tile.toString() << " via " << node->coord.toString();
+
+						if(!node->theNodeBefore)
+							EXPECT_EQ(node->coord, hero->getPosition(false)) << tile.toString();
+					}
+				}
+			}
+		}
+	}
+
 	std::shared_ptr<CGameState> gameState;
 
 	std::shared_ptr<GameCallbackMock> gameCallback;
@@ -331,3 +382,72 @@ TEST_F(CGameStateTest, battleResurrection)
 	EXPECT_EQ(unit->health.getCount(), 10);
 	EXPECT_EQ(unit->health.getResurrected(), 0);
 }
+
+TEST_F(CGameStateTest, singleDestinationPathMatchesFullSearch)
+{
+	startTestGame();
+
+	checkSingleDestinationPaths(map->heroesOnMap[0]);
+}
+
+/// Map with roads, rough terrain, lake, two-way monoliths and subterranean gate leading to underground level
+class CGameStatePathfinderTest : public CGameStateTest
+{
+public:
+	CGameStatePathfinderTest()
+		: CGameStateTest("test/PathfinderTest/")
+	{
+	}
+};
+
+TEST_F(CGameStatePathfinderTest, singleDestinationPathMatchesFullSearch)
+{
+	startTestGame();
+
+	const CGHeroInstance * hero = map->heroesOnMap[0];
+
+	//teleport exits are used only if hero's owner can see them
+	FoWChange fc;
+	fc.player = hero->tempOwner;
+	fc.mode = 1;
+	gameState->getAllTiles(fc.tiles);
+	gameCallback->sendAndApply(&fc);
+
+	{
+		CPathsInfo full(gameState->getMapSize(), hero);
+		gameState->calculatePaths(hero, full);
+
+		//underground is reachable only through subterranean gate
+		ASSERT_EQ(hero->getPosition(false).z, 0);
+		ASSERT_TRUE(full.getPathInfo(int3(6, 5, 1))->reachable());
+	}
+
+	checkSingleDestinationPaths(hero);
+}
+
+TEST_F(CGameStateTest, aiPathsAreInvalidatedByArmyChange)
+{
+	startTestGame();
+
+	const CGHeroInstance * hero = map->heroesOnMap[0];
+	ASSERT_FALSE(hero->Slots().empty());
+
+	AINodeStorage storage(gameState->getMapSize());
+	PathfinderOptions options;
+	storage.initialize(options, gameState.get(), hero);
+
+	EXPECT_TRUE(storage.isCalculatedFor(hero));
+
+	//danger of every path depends on army strength, so stored paths must not be reused
+	ChangeStackCount csc;
+	csc.army = hero->id;
+	csc.slot = hero->Slots().begin()->first;
+	csc.count = 1;
+	csc.absoluteValue = false;
+	gameCallback->sendAndApply(&csc);
+
+	EXPECT_FALSE(storage.isCalculatedFor(hero));
+
+	storage.initialize(options, gameState.get(), hero);
+	EXPECT_TRUE(storage.isCalculatedFor(hero));
+}